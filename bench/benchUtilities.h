@@ -0,0 +1,126 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Shared timing and counter helpers for the benchmark executables.
+
+
+struct BenchSample {
+    double Nanoseconds = 0.0;
+    int64_t CacheMisses = -1;   // -1 when hardware counters aren't available.
+};
+
+struct BenchResult {
+    /* Accumulates samples from repeated runs. Keeps the total and the fastest run. */
+
+    double TotalNanoseconds = 0.0;
+    double BestNanoseconds = 0.0;
+    int64_t CacheMisses = 0;
+    bool HasCacheMisses = true;
+    uint64_t Samples = 0;
+
+    void Add(const BenchSample& sample) {
+        TotalNanoseconds += sample.Nanoseconds;
+        if (Samples == 0 || sample.Nanoseconds < BestNanoseconds) {
+            BestNanoseconds = sample.Nanoseconds;
+        }
+
+        if (sample.CacheMisses < 0) {
+            HasCacheMisses = false;
+        }
+        else {
+            CacheMisses += sample.CacheMisses;
+        }
+        Samples++;
+    }
+};
+
+
+class BenchCounters {
+    /* Wall clock timer, plus a hardware cache miss counter where perf events are available (Linux, and only
+    if perf_event_paranoid allows it). Everything still works without the counter. */
+
+public:
+
+    BenchCounters() {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        CacheMissFile = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~BenchCounters() {
+#ifdef __linux__
+        if (CacheMissFile >= 0) {
+            close(CacheMissFile);
+        }
+#endif
+    }
+
+    void Start() {
+#ifdef __linux__
+        if (CacheMissFile >= 0) {
+            ioctl(CacheMissFile, PERF_EVENT_IOC_RESET, 0);
+            ioctl(CacheMissFile, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+        StartTime = std::chrono::steady_clock::now();
+    }
+
+    BenchSample Stop() {
+        BenchSample sample;
+        sample.Nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - StartTime).count();
+
+#ifdef __linux__
+        if (CacheMissFile >= 0) {
+            ioctl(CacheMissFile, PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t count = 0;
+            if (read(CacheMissFile, &count, sizeof(count)) == sizeof(count)) {
+                sample.CacheMisses = static_cast<int64_t>(count);
+            }
+        }
+#endif
+        return sample;
+    }
+
+private:
+
+    std::chrono::steady_clock::time_point StartTime;
+    int CacheMissFile = -1;
+};
+
+
+inline void PrintBenchResultFields(const uint64_t operations, const BenchResult& result) {
+    /* Print the shared JSON fields for a result. The caller writes the braces and its own fields. */
+
+    const double opsPerSample = (result.Samples == 0) ? 0.0 : static_cast<double>(operations) / result.Samples;
+
+    printf("\"ops\":%llu,\"ns_per_op\":%.3f,\"best_ns_per_op\":%.3f,", 
+        (unsigned long long)operations, 
+        result.TotalNanoseconds / (operations == 0 ? 1 : operations),
+        result.BestNanoseconds / (opsPerSample == 0.0 ? 1.0 : opsPerSample));
+
+    if (result.HasCacheMisses && result.Samples != 0) {
+        printf("\"cache_misses_per_op\":%.4f", static_cast<double>(result.CacheMisses) / (operations == 0 ? 1 : operations));
+    }
+    else {
+        printf("\"cache_misses_per_op\":null");
+    }
+}
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrentHashTable.h"
+#include "benchUtilities.h"
+
+// Stress test and benchmark for ConcurrentHashTable: reader threads look keys up while writer threads keep inserting
+// and deleting them. Every value a reader finds is checked against its key, so a torn or freed snapshot shows up as
+// an error. Prints one JSON object per line, like HashTableBench, and exits with 1 if anything was wrong.
+//
+// Usage: ConcurrentHashTableBench [keys] [writer rounds] [readers] [writers]
+// Configure with -DBENCH_THREAD_SANITIZER=ON to also build ConcurrentHashTableBenchTsan, the same test under
+// ThreadSanitizer.
+
+
+struct StressResult {
+    uint64_t Reads = 0;
+    uint64_t Hits = 0;
+    uint64_t Errors = 0;
+    double Milliseconds = 0.0;
+};
+
+static StressResult RunStress(const std::vector<std::string>& keys, const std::vector<int>& values, const uint32_t rounds, const uint32_t readers, const uint32_t writers) {
+    /* Readers loop over every key until the writers are done. With no writers, the readers run over a full table
+    for rounds passes instead. Values belong to the caller and are inserted as unmanaged, so neither Delete nor the
+    destructor frees them while a reader may still hold one. */
+
+    ConcurrentHashTable<int> table(keys.size() * 2);
+
+    if (writers == 0) {
+        for (size_t i = 0; i < keys.size(); i++) {
+            table.Insert(keys[i].c_str(), const_cast<int*>(&values[i]), false);
+        }
+    }
+
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> reads(0);
+    std::atomic<uint64_t> hits(0);
+    std::atomic<uint64_t> errors(0);
+    std::vector<std::thread> threads;
+
+    BenchCounters counters;
+    counters.Start();
+
+    for (uint32_t r = 0; r < readers; r++) {
+        threads.emplace_back([&]() {
+            uint64_t localReads = 0;
+            uint64_t localHits = 0;
+            uint64_t localErrors = 0;
+
+            for (uint32_t pass = 0; (writers == 0) ? pass < rounds : !stop.load(std::memory_order_relaxed); pass++) {
+                for (size_t i = 0; i < keys.size(); i++) {
+                    int* value = nullptr;
+                    localReads++;
+
+                    if (table.Find(keys[i].c_str(), value)) {
+                        localHits++;
+                        localErrors += (value == nullptr || *value != static_cast<int>(i)) ? 1 : 0;
+                    }
+                }
+            }
+
+            reads += localReads;
+            hits += localHits;
+            errors += localErrors;
+        });
+    }
+
+    std::vector<std::thread> writerThreads;
+
+    for (uint32_t w = 0; w < writers; w++) {
+        writerThreads.emplace_back([&, w]() {
+            // Writers work over the same keys from different starting points, so they race on the same shards.
+            for (uint32_t round = 0; round < rounds; round++) {
+                for (size_t k = 0; k < keys.size(); k++) {
+                    const size_t i = (k + w * keys.size() / writers) % keys.size();
+
+                    if (round % 2 == 0) {
+                        table.Insert(keys[i].c_str(), const_cast<int*>(&values[i]), false);
+                    }
+                    else {
+                        table.Delete(keys[i].c_str());
+                    }
+                }
+            }
+        });
+    }
+
+    for (std::thread& writer : writerThreads) {
+        writer.join();
+    }
+    stop.store(true);
+
+    for (std::thread& reader : threads) {
+        reader.join();
+    }
+
+    const BenchSample sample = counters.Stop();
+
+    // Empty the table, so a key left behind shows up as an error.
+    for (const std::string& key : keys) {
+        table.Delete(key.c_str());
+    }
+
+    uint64_t remaining = 0;
+    table.ForEach([&](const char*, int*, bool) { remaining++; });
+
+    StressResult result;
+    result.Reads = reads.load();
+    result.Hits = hits.load();
+    result.Errors = errors.load() + remaining;
+    result.Milliseconds = sample.Nanoseconds * 1e-6;
+    return result;
+}
+
+
+int main(int argc, char** argv) {
+
+    const uint32_t keyCount = (argc > 1) ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 512;
+    const uint32_t rounds = (argc > 2) ? static_cast<uint32_t>(strtoul(argv[2], nullptr, 10)) : 40;
+    const uint32_t readers = (argc > 3) ? static_cast<uint32_t>(strtoul(argv[3], nullptr, 10)) : 4;
+    const uint32_t writers = (argc > 4) ? static_cast<uint32_t>(strtoul(argv[4], nullptr, 10)) : 2;
+
+    if (keyCount == 0 || rounds == 0 || readers == 0) {
+        printf("Usage: ConcurrentHashTableBench [keys] [writer rounds] [readers] [writers]\n");
+        return 1;
+    }
+
+    std::vector<std::string> keys(keyCount);
+    std::vector<int> values(keyCount);
+
+    for (uint32_t i = 0; i < keyCount; i++) {
+        keys[i] = "assets/textures/texture_" + std::to_string(i) + ".png";
+        values[i] = static_cast<int>(i);
+    }
+
+    uint64_t errors = 0;
+
+    for (uint32_t phaseWriters : { 0u, writers }) {
+        const StressResult result = RunStress(keys, values, rounds, readers, phaseWriters);
+        errors += result.Errors;
+
+        printf("{\"bench\":\"concurrent_hash_table\",\"keys\":%u,\"readers\":%u,\"writers\":%u,\"reads\":%llu,\"hits\":%llu,\"errors\":%llu,", keyCount, readers, phaseWriters,
+            static_cast<unsigned long long>(result.Reads), static_cast<unsigned long long>(result.Hits), static_cast<unsigned long long>(result.Errors));
+        printf("\"ms\":%.3f,\"reads_per_second\":%.0f}\n", result.Milliseconds, result.Reads / std::max(result.Milliseconds * 1e-3, 1e-9));
+
+        if (phaseWriters == writers) {
+            break;
+        }
+    }
+
+    return (errors == 0) ? 0 : 1;
+}
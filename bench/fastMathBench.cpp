@@ -0,0 +1,158 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "vectorMath.h"
+#include "benchUtilities.h"
+
+// Accuracy and speed of the Fast functions in vectorMath.h against the precise versions they replace. Runs on the
+// CPU only. For every pair it prints the largest and mean error of the fast version, measured against the precise
+// one, and the time per call of each.
+// Prints one JSON object per line, like HashTableBench.
+//
+// Usage: FastMathBench [elements] [passes]
+
+
+static double ErrorOf(float precise, float fast) {
+    return fabs(static_cast<double>(precise) - fast);
+}
+
+static double ErrorOf(Vector3 precise, Vector3 fast) {
+    return fmax(ErrorOf(precise.x, fast.x), fmax(ErrorOf(precise.y, fast.y), ErrorOf(precise.z, fast.z)));
+}
+
+static double ErrorOf(Vector4 precise, Vector4 fast) {
+    return fmax(fmax(ErrorOf(precise.x, fast.x), ErrorOf(precise.y, fast.y)), fmax(ErrorOf(precise.z, fast.z), ErrorOf(precise.w, fast.w)));
+}
+
+static float SumOf(float v) { return v; }
+static float SumOf(Vector3 v) { return v.x + v.y + v.z; }
+static float SumOf(Vector4 v) { return v.x + v.y + v.z + v.w; }
+
+
+template<typename Function> static BenchResult Time(const uint32_t elements, const uint32_t passes, Function function, double& checksum) {
+    /* Time function(i) over every element, once per pass. */
+
+    BenchCounters counters;
+    BenchResult result;
+
+    for (uint32_t p = 0; p < passes; p++) {
+        float sum = 0.0f;
+
+        counters.Start();
+        for (uint32_t i = 0; i < elements; i++) {
+            sum += SumOf(function(i));
+        }
+        result.Add(counters.Stop());
+
+        checksum += sum;
+    }
+
+    return result;
+}
+
+template<typename Precise, typename Fast> static void Compare(const char* name, const uint32_t elements, const uint32_t passes, Precise precise, Fast fast, const bool relative = false) {
+    /* Print the error of fast(i) against precise(i) over every element, then time both. A relative error is
+    divided by the size of the precise result, for functions like rsqrt whose results span many magnitudes. */
+
+    double maxError = 0.0;
+    double totalError = 0.0;
+
+    for (uint32_t i = 0; i < elements; i++) {
+        const auto expected = precise(i);
+        double error = ErrorOf(expected, fast(i));
+
+        if (relative) {
+            const double size = fabs(static_cast<double>(SumOf(expected)));
+            error /= (size == 0.0) ? 1.0 : size;
+        }
+
+        maxError = fmax(maxError, error);
+        totalError += error;
+    }
+
+    double checksum = 0.0;
+    const BenchResult preciseResult = Time(elements, passes, precise, checksum);
+    const BenchResult fastResult = Time(elements, passes, fast, checksum);
+
+    const double operations = static_cast<double>(elements) * passes;
+    const double preciseNanoseconds = preciseResult.TotalNanoseconds / operations;
+    const double fastNanoseconds = fastResult.TotalNanoseconds / operations;
+
+    printf("{\"bench\":\"fast_math\",\"function\":\"%s\",\"error\":\"%s\",\"max_error\":%.3g,\"mean_error\":%.3g,", name, relative ? "relative" : "absolute", maxError, totalError / elements);
+    printf("\"precise_ns_per_op\":%.3f,\"fast_ns_per_op\":%.3f,\"speedup\":%.2f,\"checksum\":%.6g}\n",
+        preciseNanoseconds, fastNanoseconds, preciseNanoseconds / (fastNanoseconds == 0.0 ? 1.0 : fastNanoseconds), checksum);
+}
+
+
+int main(int argc, char** argv) {
+
+    const uint32_t elements = (argc > 1) ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 65536;
+    const uint32_t passes = (argc > 2) ? static_cast<uint32_t>(strtoul(argv[2], nullptr, 10)) : 50;
+
+    if (elements == 0 || passes == 0) {
+        printf("Usage: FastMathBench [elements] [passes]\n");
+        return 1;
+    }
+
+    // Angles a few turns either way, like accumulated camera and animation angles, and unit rotations.
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> angle(-4.0f * PI, 4.0f * PI);
+    std::uniform_real_distribution<float> value(-4.0f, 4.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    std::vector<float> angles(elements);
+    std::vector<float> amounts(elements);
+    std::vector<float> positives(elements);
+    std::vector<Vector3> vectors(elements);
+    std::vector<Vector3> axes(elements);
+    std::vector<Quaternion> from(elements);
+    std::vector<Quaternion> to(elements);
+
+    for (uint32_t i = 0; i < elements; i++) {
+        angles[i] = angle(rng);
+        amounts[i] = unit(rng);
+        positives[i] = expf(value(rng) * 4.0f);
+        vectors[i] = Vector3{ value(rng), value(rng), value(rng) };
+        axes[i] = Vector3{ value(rng), value(rng), value(rng) };
+        from[i] = Normalize(Quaternion{ value(rng), value(rng), value(rng), value(rng) });
+        to[i] = Normalize(Quaternion{ value(rng), value(rng), value(rng), value(rng) });
+    }
+
+    Compare("rsqrt", elements, passes,
+        [&](uint32_t i) { return 1.0f / sqrtf(positives[i]); },
+        [&](uint32_t i) { return FastRsqrt(positives[i]); }, true);
+
+    Compare("sin", elements, passes,
+        [&](uint32_t i) { return sinf(angles[i]); },
+        [&](uint32_t i) { return FastSin(angles[i]); });
+
+    Compare("cos", elements, passes,
+        [&](uint32_t i) { return cosf(angles[i]); },
+        [&](uint32_t i) { return FastCos(angles[i]); });
+
+    Compare("normalize_vector3", elements, passes,
+        [&](uint32_t i) { return Normalize(vectors[i]); },
+        [&](uint32_t i) { return FastNormalize(vectors[i]); });
+
+    Compare("normalize_quaternion", elements, passes,
+        [&](uint32_t i) { return Normalize(from[i] * 2.0f); },
+        [&](uint32_t i) { return FastNormalize(from[i] * 2.0f); });
+
+    Compare("from_axis_angle", elements, passes,
+        [&](uint32_t i) { return FromAxisAngle(axes[i], angles[i]); },
+        [&](uint32_t i) { return FastFromAxisAngle(axes[i], angles[i]); });
+
+    Compare("rotate_axis_angle", elements, passes,
+        [&](uint32_t i) { return Rotate(vectors[i], axes[i], angles[i]); },
+        [&](uint32_t i) { return FastRotate(vectors[i], axes[i], angles[i]); });
+
+    Compare("slerp", elements, passes,
+        [&](uint32_t i) { return Slerp(from[i], to[i], amounts[i]); },
+        [&](uint32_t i) { return FastSlerp(from[i], to[i], amounts[i]); });
+
+    return 0;
+}
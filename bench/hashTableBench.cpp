@@ -0,0 +1,483 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "hashTable.h"
+#include "staticHashTable.h"
+#include "benchUtilities.h"
+
+// Benchmark for HashTable against std::unordered_map and a plain linear probing table.
+// Prints one JSON object per line so results can be diffed or loaded into a spreadsheet.
+//
+// Checks first that HashTable frees only the values it manages, and exits with 1 if it doesn't.
+//
+// Usage: HashTableBench [capacity] [repeats]
+
+
+class LinearProbeTable {
+    /* Reference open addressing table. This is the design HashTable used before the control byte rewrite:
+    one array of fat items, heap allocated keys, linear probing and tombstones. */
+
+    struct Item {
+        char* Key = nullptr;
+        uint64_t KeyLength = 0;
+        uint64_t Hash = 0;
+        int* Value = nullptr;
+        bool Deleted = false;
+    };
+
+public:
+
+    LinearProbeTable(uint64_t size) {
+        Size = (size < 16) ? 16 : Pow2Ceiling<uint64_t>(size);
+        Array = new Item[Size];
+        SlotsUsed = 0;
+    }
+
+    ~LinearProbeTable() {
+        for (uint64_t i = 0; i < Size; i++) {
+            delete[] Array[i].Key;
+        }
+        delete[] Array;
+    }
+
+    void Insert(const char* key, int* value) {
+
+        if (++SlotsUsed == Size) {
+            Expand();
+        }
+
+        const char* keyEnd = FindBufferEnd(key);
+        uint64_t hash = fnvHash64(key, keyEnd);
+        uint64_t slot = hash & (Size - 1);
+
+        while (Array[slot].Key != nullptr) {
+            slot = (slot + 1) & (Size - 1);
+        }
+
+        Array[slot].KeyLength = keyEnd - key;
+        Array[slot].Key = new char[Array[slot].KeyLength + 1];
+        memcpy(Array[slot].Key, key, Array[slot].KeyLength + 1);
+        Array[slot].Hash = hash;
+        Array[slot].Value = value;
+        Array[slot].Deleted = false;
+    }
+
+    bool Find(const char* key, int*& outValue) {
+        int64_t slot = FindSlot(key);
+
+        if (slot < 0) {
+            return false;
+        }
+        outValue = Array[slot].Value;
+        return true;
+    }
+
+    bool Delete(const char* key) {
+        int64_t slot = FindSlot(key);
+
+        if (slot < 0) {
+            return false;
+        }
+
+        delete[] Array[slot].Key;
+        Array[slot].Key = nullptr;
+        Array[slot].Deleted = true;
+        SlotsUsed--;
+        return true;
+    }
+
+    void Expand() {
+        uint64_t newSize = Size << 1;
+        Item* temp = new Item[newSize];
+
+        for (uint64_t i = 0; i < Size; i++) {
+            if (Array[i].Key == nullptr) {
+                continue;
+            }
+
+            uint64_t slot = Array[i].Hash & (newSize - 1);
+            while (temp[slot].Key != nullptr) {
+                slot = (slot + 1) & (newSize - 1);
+            }
+            temp[slot] = Array[i];
+        }
+
+        delete[] Array;
+        Array = temp;
+        Size = newSize;
+    }
+
+    double LoadFactor() const { return static_cast<double>(SlotsUsed) / Size; }
+
+private:
+
+    uint64_t Size;
+    uint64_t SlotsUsed;
+    Item* Array;
+
+    int64_t FindSlot(const char* key) {
+        const char* keyEnd = FindBufferEnd(key);
+        const uint64_t keyLength = keyEnd - key;
+        uint64_t hash = fnvHash64(key, keyEnd);
+        uint64_t slot = hash & (Size - 1);
+
+        for (uint64_t i = 0; i < Size; i++) {
+            const Item& item = Array[slot];
+
+            if (item.Key == nullptr && !item.Deleted) {
+                return -1;
+            }
+
+            if (item.Key != nullptr && item.Hash == hash && item.KeyLength == keyLength && memcmp(item.Key, key, keyLength) == 0) {
+                return static_cast<int64_t>(slot);
+            }
+
+            slot = (slot + 1) & (Size - 1);
+        }
+        return -1;
+    }
+};
+
+
+// Adapters giving every table the same interface.
+
+struct HashTableAdapter {
+    static const char* Name() { return "HashTable"; }
+
+    HashTable<int> Table;
+    explicit HashTableAdapter(uint64_t capacity) : Table(capacity) { }
+
+    // The values belong to the benchmark, so the table doesn't manage them.
+    void Insert(const std::string& key, int* value) { Table.Insert(key.c_str(), value, false); }
+    bool Find(const std::string& key, int*& out) { return Table.Find(key.c_str(), out); }
+    bool Delete(const std::string& key) { return Table.Delete(key.c_str()); }
+    void Expand() { Table.Expand(); }
+    double LoadFactor() const { return static_cast<double>(Table.SlotsUsed) / Table.Size; }
+};
+
+struct HashTableLengthAdapter : HashTableAdapter {
+    /* Same table, passing the key length along so the null terminator scan is skipped. */
+    static const char* Name() { return "HashTable(length)"; }
+
+    explicit HashTableLengthAdapter(uint64_t capacity) : HashTableAdapter(capacity) { }
+
+    void Insert(const std::string& key, int* value) { Table.Insert(key.c_str(), key.size(), value, false); }
+    bool Find(const std::string& key, int*& out) { return Table.Find(key.c_str(), key.size(), out); }
+    bool Delete(const std::string& key) { return Table.Delete(key.c_str(), key.size()); }
+};
+
+struct UnorderedMapAdapter {
+    static const char* Name() { return "std::unordered_map"; }
+
+    std::unordered_map<std::string, int*> Table;
+    explicit UnorderedMapAdapter(uint64_t capacity) { Table.max_load_factor(1.0f); Table.reserve(capacity); }
+
+    void Insert(const std::string& key, int* value) { Table.emplace(key, value); }
+    bool Find(const std::string& key, int*& out) {
+        auto it = Table.find(key);
+        if (it == Table.end()) {
+            return false;
+        }
+        out = it->second;
+        return true;
+    }
+    bool Delete(const std::string& key) { return Table.erase(key) != 0; }
+    void Expand() { Table.rehash(Table.bucket_count() * 2); }
+    double LoadFactor() const { return Table.load_factor(); }
+};
+
+struct LinearProbeAdapter {
+    static const char* Name() { return "LinearProbe"; }
+
+    LinearProbeTable Table;
+    explicit LinearProbeAdapter(uint64_t capacity) : Table(capacity) { }
+
+    void Insert(const std::string& key, int* value) { Table.Insert(key.c_str(), value); }
+    bool Find(const std::string& key, int*& out) { return Table.Find(key.c_str(), out); }
+    bool Delete(const std::string& key) { return Table.Delete(key.c_str()); }
+    void Expand() { Table.Expand(); }
+    double LoadFactor() const { return Table.LoadFactor(); }
+};
+
+
+static std::vector<std::string> GenerateKeys(const char* distribution, const uint64_t count, const char* prefix, uint32_t seed) {
+    /* Make keys shaped like real asset names. "alias" is a short name like the ones passed to CreateTexture,
+    "path" is a file path like the ones used when no alias is given. */
+
+    static const char Alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_";
+    static const char* Folders[] = { "textures", "meshes", "shaders", "fonts", "scenes", "characters", "props", "environment" };
+
+    std::mt19937 rng(seed);
+    std::vector<std::string> keys;
+    keys.reserve(count);
+
+    const bool isPath = strcmp(distribution, "path") == 0;
+
+    for (uint64_t i = 0; i < count; i++) {
+        std::string key = prefix;
+
+        if (isPath) {
+            key += "./assets/";
+            uint32_t depth = 1 + rng() % 4;
+            for (uint32_t d = 0; d < depth; d++) {
+                key += Folders[rng() % 8];
+                key += '/';
+            }
+        }
+
+        // Aliases stay under the 36 byte alias limit once the index is added.
+        uint32_t length = isPath ? 6 + rng() % 24 : 4 + rng() % 24;
+        for (uint32_t c = 0; c < length; c++) {
+            key += Alphabet[rng() % (sizeof(Alphabet) - 1)];
+        }
+
+        // The index keeps every key unique.
+        key += std::to_string(i);
+
+        if (isPath) {
+            key += ".png";
+        }
+
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+
+struct BenchConfig {
+    const char* Distribution;
+    double LoadFactor;          // The load factor asked for. Tables that grow early end up below it.
+    uint64_t Capacity;
+    uint64_t Repeats;
+};
+
+static void PrintHashTableResult(const char* table, const char* operation, const BenchConfig& config, const double loadFactor, const uint64_t operations, const BenchResult& result) {
+    /* loadFactor is what the table really held after the inserts, target_load_factor what the run asked for. */
+    printf("{\"bench\":\"hash_table\",\"table\":\"%s\",\"op\":\"%s\",\"keys\":\"%s\",\"target_load_factor\":%.3f,\"load_factor\":%.3f,\"capacity\":%llu,",
+        table, operation, config.Distribution, config.LoadFactor, loadFactor, (unsigned long long)config.Capacity);
+    PrintBenchResultFields(operations, result);
+    printf("}\n");
+}
+
+template<typename Table> static void RunTable(const BenchConfig& config, const std::vector<std::string>& keys, const std::vector<std::string>& missKeys, std::vector<int*>& values) {
+
+    const uint64_t count = keys.size();
+    std::vector<uint64_t> order(count);
+    for (uint64_t i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937(7));
+
+    BenchCounters counters;
+    BenchResult result;
+    int* out = nullptr;
+    uint64_t sink = 0;
+
+    Table table(config.Capacity);
+    for (uint64_t i = 0; i < count; i++) {
+        table.Insert(keys[i], values[i]);
+    }
+    const double loadFactor = table.LoadFactor();
+
+    // Insert into a fresh table each repeat.
+    result = BenchResult();
+    for (uint64_t r = 0; r < config.Repeats; r++) {
+        Table insertTable(config.Capacity);
+        counters.Start();
+        for (uint64_t i = 0; i < count; i++) {
+            insertTable.Insert(keys[i], values[i]);
+        }
+        result.Add(counters.Stop());
+    }
+    PrintHashTableResult(Table::Name(), "insert", config, loadFactor, count * config.Repeats, result);
+
+    // Lookups that hit, in shuffled order so the probe sequence isn't the insert order.
+    result = BenchResult();
+    for (uint64_t r = 0; r < config.Repeats; r++) {
+        counters.Start();
+        for (uint64_t i = 0; i < count; i++) {
+            sink += table.Find(keys[order[i]], out);
+        }
+        result.Add(counters.Stop());
+    }
+    PrintHashTableResult(Table::Name(), "find_hit", config, loadFactor, count * config.Repeats, result);
+
+    // Lookups that miss walk the longest probe sequences.
+    result = BenchResult();
+    for (uint64_t r = 0; r < config.Repeats; r++) {
+        counters.Start();
+        for (uint64_t i = 0; i < count; i++) {
+            sink += table.Find(missKeys[i], out);
+        }
+        result.Add(counters.Stop());
+    }
+    PrintHashTableResult(Table::Name(), "find_miss", config, loadFactor, count * config.Repeats, result);
+
+    // Delete every other key, then look all of them up. This is where tombstones matter.
+    for (uint64_t i = 0; i < count; i += 2) {
+        table.Delete(keys[i]);
+    }
+
+    result = BenchResult();
+    for (uint64_t r = 0; r < config.Repeats; r++) {
+        counters.Start();
+        for (uint64_t i = 0; i < count; i++) {
+            sink += table.Find(keys[order[i]], out);
+        }
+        result.Add(counters.Stop());
+    }
+    PrintHashTableResult(Table::Name(), "delete_then_find", config, loadFactor, count * config.Repeats, result);
+
+    // Expand is measured per item moved.
+    result = BenchResult();
+    for (uint64_t r = 0; r < config.Repeats; r++) {
+        Table expandTable(config.Capacity);
+        for (uint64_t i = 0; i < count; i++) {
+            expandTable.Insert(keys[i], values[i]);
+        }
+        counters.Start();
+        expandTable.Expand();
+        result.Add(counters.Stop());
+    }
+    PrintHashTableResult(Table::Name(), "expand", config, loadFactor, count * config.Repeats, result);
+
+    // Keep the compiler from dropping the lookups.
+    if (sink == 0xFFFFFFFFFFFFFFFF) {
+        printf("\n");
+    }
+}
+
+static void RunStaticTable(const BenchConfig& config, const std::vector<std::string>& keys, const std::vector<std::string>& missKeys, std::vector<int*>& values) {
+    /* StaticHashTable can't insert or delete, so it only reports the build and the lookups. */
+
+    const uint64_t count = keys.size();
+    std::vector<uint64_t> order(count);
+    for (uint64_t i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937(7));
+
+    std::vector<StringId> ids;
+    for (const std::string& key : keys) {
+        ids.emplace_back(key);
+    }
+
+    BenchCounters counters;
+    BenchResult result;
+    int* out = nullptr;
+    uint64_t sink = 0;
+    StaticHashTable<int> table;
+
+    result = BenchResult();
+    for (uint64_t r = 0; r < config.Repeats; r++) {
+        counters.Start();
+        table.Build(ids.data(), values.data(), count);
+        result.Add(counters.Stop());
+    }
+    PrintHashTableResult("StaticHashTable", "build", config, 1.0, count * config.Repeats, result);
+
+    result = BenchResult();
+    for (uint64_t r = 0; r < config.Repeats; r++) {
+        counters.Start();
+        for (uint64_t i = 0; i < count; i++) {
+            sink += table.Find(keys[order[i]].c_str(), keys[order[i]].size(), out);
+        }
+        result.Add(counters.Stop());
+    }
+    PrintHashTableResult("StaticHashTable", "find_hit", config, 1.0, count * config.Repeats, result);
+
+    result = BenchResult();
+    for (uint64_t r = 0; r < config.Repeats; r++) {
+        counters.Start();
+        for (uint64_t i = 0; i < count; i++) {
+            sink += table.Find(missKeys[i].c_str(), missKeys[i].size(), out);
+        }
+        result.Add(counters.Stop());
+    }
+    PrintHashTableResult("StaticHashTable", "find_miss", config, 1.0, count * config.Repeats, result);
+
+    // Keep the compiler from dropping the lookups.
+    if (sink == 0xFFFFFFFFFFFFFFFF) {
+        printf("\n");
+    }
+}
+
+
+struct OwnershipProbe {
+    /* Counts destructions, so the ownership check can tell which values a table freed. */
+    static uint32_t Destroyed;
+    ~OwnershipProbe() { Destroyed++; }
+};
+
+uint32_t OwnershipProbe::Destroyed = 0;
+
+static bool CheckOwnership() {
+    /* HashTable has to free managed values, in Delete and when destroyed, and leave unmanaged ones alone. */
+
+    OwnershipProbe* managed = new OwnershipProbe();
+    OwnershipProbe* deleted = new OwnershipProbe();
+    OwnershipProbe unmanaged[2];
+
+    {
+        HashTable<OwnershipProbe> table(16);
+        table.Insert("managed", managed, true);
+        table.Insert("deleted", deleted, true);
+        table.Insert("unmanaged", &unmanaged[0], false);
+        table.Insert("unmanaged deleted", &unmanaged[1], false);
+
+        table.Delete("deleted");
+        table.Delete("unmanaged deleted");
+    }
+
+    const bool match = OwnershipProbe::Destroyed == 2;
+    printf("{\"bench\":\"hash_table\",\"check\":\"ownership\",\"freed\":%u,\"match\":%s}\n", OwnershipProbe::Destroyed, match ? "true" : "false");
+    return match;
+}
+
+
+int main(int argc, char** argv) {
+
+    uint64_t capacity = (argc > 1) ? strtoull(argv[1], nullptr, 10) : 4096;
+    uint64_t repeats = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 5;
+
+    if (!CheckOwnership()) {
+        return 1;
+    }
+
+    const char* distributions[] = { "alias", "path" };
+    const double loadFactors[] = { 0.25, 0.5, 0.75, 0.875, 0.95 };
+
+    for (const char* distribution : distributions) {
+        for (const double loadFactor : loadFactors) {
+
+            BenchConfig config{ distribution, loadFactor, capacity, repeats };
+            uint64_t count = static_cast<uint64_t>(capacity * loadFactor);
+
+            std::vector<std::string> keys = GenerateKeys(distribution, count, "", 1);
+            std::vector<std::string> missKeys = GenerateKeys(distribution, count, "miss_", 2);
+
+            std::vector<int*> values(count);
+            std::vector<int> valueStorage(count);
+            for (uint64_t i = 0; i < count; i++) {
+                valueStorage[i] = static_cast<int>(i);
+                values[i] = &valueStorage[i];
+            }
+
+            RunTable<HashTableAdapter>(config, keys, missKeys, values);
+            RunTable<HashTableLengthAdapter>(config, keys, missKeys, values);
+            RunTable<UnorderedMapAdapter>(config, keys, missKeys, values);
+            RunTable<LinearProbeAdapter>(config, keys, missKeys, values);
+            RunStaticTable(config, keys, missKeys, values);
+        }
+    }
+
+    return 0;
+}
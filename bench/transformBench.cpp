@@ -0,0 +1,124 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "jobSystem.h"
+#include "transform.h"
+#include "benchUtilities.h"
+
+// Benchmark for TransformStore::UpdateTransforms, serial and on the job system at 1, 2, 4, 8 and 16 threads.
+// Every frame moves all the roots, so every world matrix in the scene is recomputed.
+// Prints one JSON object per line, like HashTableBench.
+//
+// Usage: TransformBench [transforms] [depth] [frames]
+
+
+static void BuildScene(TransformStore& store, const uint32_t count, const uint32_t depth, std::vector<TransformHandle>& roots) {
+    /* A forest split evenly into depth levels. Each transform is parented to a random one in the level above, so
+    siblings are spread out the way they would be after a scene has been loaded and edited. */
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> offset(-4.0f, 4.0f);
+
+    const uint32_t levelSize = (count + depth - 1) / depth;
+    std::vector<TransformHandle> previousLevel;
+    std::vector<TransformHandle> level;
+    uint32_t created = 0;
+
+    for (uint32_t d = 0; d < depth && created < count; d++) {
+
+        level.clear();
+        for (uint32_t i = 0; i < levelSize && created < count; i++, created++) {
+            const TransformHandle handle = store.Create();
+            store.SetPosition(handle, Vector3{ offset(rng), offset(rng), offset(rng) });
+            store.SetRotation(handle, FromAxisAngle(V3_UP, offset(rng)));
+
+            if (!previousLevel.empty()) {
+                store.SetParent(handle, previousLevel[rng() % previousLevel.size()]);
+            }
+            level.push_back(handle);
+        }
+
+        if (d == 0) {
+            roots = level;
+        }
+        previousLevel.swap(level);
+    }
+}
+
+static void MoveRoots(TransformStore& store, const std::vector<TransformHandle>& roots, const uint32_t frame) {
+    for (const TransformHandle root : roots) {
+        store.SetRotation(root, FromAxisAngle(V3_UP, 0.01f * frame));
+    }
+}
+
+static double Checksum(TransformStore& store) {
+    /* Sum of every world translation, to check every thread count produces the same scene. */
+    double sum = 0.0;
+    for (uint32_t i = 0; i < store.Count(); i++) {
+        sum += store.WorldMatrices[i].m12 + store.WorldMatrices[i].m13 + store.WorldMatrices[i].m14;
+    }
+    return sum;
+}
+
+static void PrintTransformResult(const char* mode, const uint32_t threads, const uint32_t count, const uint32_t depth, const uint64_t operations, const BenchResult& result, const double speedup, const double checksum) {
+    printf("{\"bench\":\"transform_update\",\"mode\":\"%s\",\"threads\":%u,\"transforms\":%u,\"depth\":%u,", mode, threads, count, depth);
+    PrintBenchResultFields(operations, result);
+    printf(",\"speedup\":%.3f,\"checksum\":%.6g}\n", speedup, checksum);
+}
+
+
+int main(int argc, char** argv) {
+
+    const uint32_t count = (argc > 1) ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 100000;
+    const uint32_t depth = (argc > 2) ? static_cast<uint32_t>(strtoul(argv[2], nullptr, 10)) : 8;
+    const uint32_t frames = (argc > 3) ? static_cast<uint32_t>(strtoul(argv[3], nullptr, 10)) : 50;
+
+    if (count == 0 || depth == 0 || frames == 0) {
+        printf("Usage: TransformBench [transforms] [depth] [frames]\n");
+        return 1;
+    }
+
+    TransformStore store(count);
+    std::vector<TransformHandle> roots;
+    BuildScene(store, count, depth, roots);
+
+    BenchCounters counters;
+    BenchResult result;
+
+    // Single threaded path first, as the baseline.
+    store.UpdateTransforms();
+    for (uint32_t f = 0; f < frames; f++) {
+        MoveRoots(store, roots, f);
+        counters.Start();
+        store.UpdateTransforms();
+        result.Add(counters.Stop());
+    }
+
+    const double serialNanoseconds = result.TotalNanoseconds;
+    PrintTransformResult("serial", 1, count, depth, static_cast<uint64_t>(count) * frames, result, 1.0, Checksum(store));
+
+    const uint32_t threadCounts[] = { 1, 2, 4, 8, 16 };
+
+    for (const uint32_t threads : threadCounts) {
+
+        JobSystem jobs(threads);
+        result = BenchResult();
+
+        // The first threaded update sorts the arrays into levels, keep it out of the timing.
+        store.UpdateTransforms(jobs);
+
+        for (uint32_t f = 0; f < frames; f++) {
+            MoveRoots(store, roots, f);
+            counters.Start();
+            store.UpdateTransforms(jobs);
+            result.Add(counters.Stop());
+        }
+
+        PrintTransformResult("jobs", threads, count, depth, static_cast<uint64_t>(count) * frames, result, serialNanoseconds / result.TotalNanoseconds, Checksum(store));
+    }
+
+    return 0;
+}
@@ -0,0 +1,233 @@
+#include <bitset>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "vectorMath.h"
+#include "benchUtilities.h"
+
+// Benchmark for the Matrix and Quaternion kernels, the batch point transforms and the frustum culling in vectorMath.h. Built twice, as
+// VectorMathBench with whatever SIMD the compiler targets and as VectorMathBenchScalar with VECTOR_MATH_NO_SIMD, so the
+// two can be compared directly. The checksums should match between the two to within rounding, and the cull rows
+// report whether the batch masks match testing each object on its own.
+// Prints one JSON object per line, like HashTableBench.
+//
+// Usage: VectorMathBench [elements] [passes]
+
+
+#if defined(VECTOR_MATH_USE_AVX)
+static const char* KernelName = "avx";
+#elif defined(VECTOR_MATH_USE_FMA)
+static const char* KernelName = "fma";
+#elif defined(VECTOR_MATH_USE_SSE)
+static const char* KernelName = "sse";
+#else
+static const char* KernelName = "scalar";
+#endif
+
+
+// Every component goes into the checksum, so no kernel can skip computing part of its result.
+static float SumOf(const Vector4& v) {
+    return v.x + v.y + v.z + v.w;
+}
+
+static float SumOf(const float* values) {
+    float sum = 0.0f;
+    for (int i = 0; i < 16; i++) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+static float SumOf(const Matrix& m) {
+    return SumOf(reinterpret_cast<const float*>(&m));
+}
+
+
+template<typename Function> static void RunKernel(const char* name, const uint32_t elements, const uint32_t passes, Function function) {
+    /* Time function(i) over every element, once per pass. It returns a float to add to the checksum. */
+
+    BenchCounters counters;
+    BenchResult result;
+    double checksum = 0.0;
+
+    for (uint32_t p = 0; p < passes; p++) {
+        float sum = 0.0f;
+
+        counters.Start();
+        for (uint32_t i = 0; i < elements; i++) {
+            sum += function(i);
+        }
+        result.Add(counters.Stop());
+
+        checksum += sum;
+    }
+
+    printf("{\"bench\":\"vector_math\",\"kernel\":\"%s\",\"simd\":\"%s\",", name, KernelName);
+    PrintBenchResultFields(static_cast<uint64_t>(elements) * passes, result);
+    printf(",\"checksum\":%.6g}\n", checksum);
+}
+
+template<typename Function> static void RunBatch(const char* name, const uint32_t elements, const uint32_t passes, Function function) {
+    /* Time function() once per pass. It transforms every element and returns a float for the checksum. */
+
+    BenchCounters counters;
+    BenchResult result;
+    double checksum = 0.0;
+
+    for (uint32_t p = 0; p < passes; p++) {
+        counters.Start();
+        const float sum = function();
+        result.Add(counters.Stop());
+
+        checksum += sum;
+    }
+
+    printf("{\"bench\":\"vector_math\",\"kernel\":\"%s\",\"simd\":\"%s\",", name, KernelName);
+    PrintBenchResultFields(static_cast<uint64_t>(elements) * passes, result);
+    printf(",\"checksum\":%.6g}\n", checksum);
+}
+
+template<typename Function> static void RunCull(const char* name, const uint32_t elements, const uint32_t passes, const std::vector<uint64_t>& expected, std::vector<uint64_t>& visible, Function function) {
+    /* Time function() once per pass, like RunBatch. It fills visible and returns how many are visible. Afterwards
+    visible has to match expected, the mask from testing each object on its own, bit for bit. */
+
+    BenchCounters counters;
+    BenchResult result;
+    double checksum = 0.0;
+    size_t count = 0;
+
+    for (uint32_t p = 0; p < passes; p++) {
+        counters.Start();
+        count = function();
+        result.Add(counters.Stop());
+
+        checksum += static_cast<double>(count);
+    }
+
+    size_t expectedCount = 0;
+    bool match = true;
+    for (size_t w = 0; w < expected.size(); w++) {
+        expectedCount += static_cast<size_t>(std::bitset<64>(expected[w]).count());
+        match = match && visible[w] == expected[w];
+    }
+    match = match && count == expectedCount;
+
+    printf("{\"bench\":\"vector_math\",\"kernel\":\"%s\",\"simd\":\"%s\",", name, KernelName);
+    PrintBenchResultFields(static_cast<uint64_t>(elements) * passes, result);
+    printf(",\"checksum\":%.6g,\"match\":%s}\n", checksum, match ? "true" : "false");
+}
+
+
+int main(int argc, char** argv) {
+
+    const uint32_t elements = (argc > 1) ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 4096;
+    const uint32_t passes = (argc > 2) ? static_cast<uint32_t>(strtoul(argv[2], nullptr, 10)) : 200;
+
+    if (elements == 0 || passes == 0) {
+        printf("Usage: VectorMathBench [elements] [passes]\n");
+        return 1;
+    }
+
+    // Rotations and translations, like the transforms these kernels see in a frame.
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> value(-4.0f, 4.0f);
+
+    std::vector<Matrix> matrices(elements);
+    std::vector<Quaternion> quaternions(elements);
+    std::vector<Vector4> vectors(elements);
+    std::vector<GpuMatrix> gpuMatrices(elements);
+    std::vector<Vector3> points(elements);
+    std::vector<Vector3> transformedPoints(elements);
+    std::vector<float> xs(elements), ys(elements), zs(elements);
+    std::vector<float> outX(elements), outY(elements), outZ(elements);
+    std::vector<float> radii(elements);
+    std::vector<float> maxX(elements), maxY(elements), maxZ(elements);
+    std::vector<uint64_t> visible((elements + 63) / 64);
+
+    for (uint32_t i = 0; i < elements; i++) {
+        quaternions[i] = Normalize(Quaternion{ value(rng), value(rng), value(rng), value(rng) });
+        matrices[i] = ToMatrix(quaternions[i]) * Translate(value(rng), value(rng), value(rng));
+        vectors[i] = Vector4{ value(rng), value(rng), value(rng), 1.0f };
+        points[i] = Vector3{ value(rng), value(rng), value(rng) };
+        xs[i] = points[i].x;
+        ys[i] = points[i].y;
+        zs[i] = points[i].z;
+        radii[i] = value(rng) * 0.25f + 1.0f;
+        maxX[i] = xs[i] + radii[i];
+        maxY[i] = ys[i] + radii[i];
+        maxZ[i] = zs[i] + radii[i];
+    }
+
+    const Matrix viewProjection = Translate(0.0f, -1.0f, -5.0f) * Perspective(DEG2RAD * 70.0f, 16.0 / 9.0, 0.01, 1024.0);
+
+    RunKernel("matrix_multiply", elements, passes, [&](uint32_t i) { return SumOf(matrices[i] * viewProjection); });
+    RunKernel("matrix_vector4", elements, passes, [&](uint32_t i) { return SumOf(matrices[i] * vectors[i]); });
+    RunKernel("matrix_invert", elements, passes, [&](uint32_t i) { return SumOf(Invert(matrices[i])); });
+    RunKernel("quaternion_multiply", elements, passes, [&](uint32_t i) { return SumOf(Multiply(quaternions[i], quaternions[elements - 1 - i])); });
+    RunKernel("quaternion_normalize", elements, passes, [&](uint32_t i) { return SumOf(Normalize(quaternions[i] * 2.0f)); });
+
+    // Matrices to GPU layout, one at a time like a draw loop and all at once like an instance buffer upload.
+    RunKernel("to_float16", elements, passes, [&](uint32_t i) { return SumOf(ToFloat16(matrices[i]).v); });
+
+    RunBatch("to_gpu_matrices", elements, passes, [&]() {
+        ToGpuMatrices(matrices.data(), elements, gpuMatrices.data());
+        return SumOf(gpuMatrices[elements - 1].v);
+    });
+
+    // Every point through one matrix: a loop over Multiply, then the batch functions on the same points.
+    const Matrix& model = matrices[0];
+
+    RunBatch("transform_points_loop", elements, passes, [&]() {
+        for (uint32_t i = 0; i < elements; i++) {
+            transformedPoints[i] = Multiply(points[i], model);
+        }
+        return transformedPoints[elements - 1].x;
+    });
+
+    RunBatch("transform_points_aos", elements, passes, [&]() {
+        TransformPoints(model, points.data(), elements, transformedPoints.data());
+        return transformedPoints[elements - 1].x;
+    });
+
+    RunBatch("transform_points_soa", elements, passes, [&]() {
+        TransformPoints(model, xs.data(), ys.data(), zs.data(), elements, outX.data(), outY.data(), outZ.data());
+        return outX[elements - 1];
+    });
+
+    // Bounds against a frustum that sees about half of them: one at a time, then the batch functions.
+    const FrustumPlanes frustum = ToFrustumPlanes(Translate(0.0f, 0.0f, 2.0f) * Perspective(DEG2RAD * 70.0f, 16.0 / 9.0, 0.01, 1024.0));
+
+    RunBatch("cull_spheres_loop", elements, passes, [&]() {
+        size_t count = 0;
+        for (uint32_t i = 0; i < elements; i++) {
+            count += SphereInFrustum(frustum, points[i], radii[i]);
+        }
+        return static_cast<float>(count);
+    });
+
+    // What the batch functions have to agree with, from SphereInFrustum and BoxInFrustum one object at a time.
+    std::vector<uint64_t> expectedSpheres(visible.size(), 0);
+    std::vector<uint64_t> expectedBoxes(visible.size(), 0);
+
+    for (uint32_t i = 0; i < elements; i++) {
+        if (SphereInFrustum(frustum, points[i], radii[i])) {
+            expectedSpheres[i / 64] |= 1ull << (i % 64);
+        }
+        if (BoxInFrustum(frustum, points[i], Vector3{ maxX[i], maxY[i], maxZ[i] })) {
+            expectedBoxes[i / 64] |= 1ull << (i % 64);
+        }
+    }
+
+    RunCull("cull_spheres", elements, passes, expectedSpheres, visible, [&]() {
+        return TestSpheres(frustum, xs.data(), ys.data(), zs.data(), radii.data(), elements, visible.data());
+    });
+
+    RunCull("cull_boxes", elements, passes, expectedBoxes, visible, [&]() {
+        return TestBoxes(frustum, xs.data(), ys.data(), zs.data(), maxX.data(), maxY.data(), maxZ.data(), elements, visible.data());
+    });
+
+    return 0;
+}
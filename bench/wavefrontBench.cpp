@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "jobSystem.h"
+#include "meshCache.h"
+#include "vectorMath.h"
+#include "wavefront.h"
+#include "benchUtilities.h"
+
+// Benchmark for loading .obj files: the stream based parser CreateStaticMeshFromWavefront used to have against
+// LoadWavefront. Both read the file from disk on every pass, so the page cache is warm for both. Also times
+// BuildWavefrontVertices and reports how many distinct vertices each file has, and compares parsing and building
+// the vertices against mapping a .dmesh cache of the same file. The caches are written to the working directory.
+// Then parses a large generated file in memory on 1, 2, 4, ... threads to show how ParseWavefront scales.
+// Prints one JSON object per line, like HashTableBench.
+//
+// Usage: WavefrontBench [passes] [file.obj ...]
+// With no files it loads every .obj in assets/meshes, found when CMake configured the benchmark.
+
+
+struct LegacyWavefront {
+    std::vector<Vector3> Positions;
+    std::vector<Vector2> TextureCoords;
+    std::vector<Vector3> Normals;
+    std::vector<uint16_t> PositionIndices;
+    std::vector<uint16_t> TextureCoordIndices;
+    std::vector<uint16_t> NormalIndices;
+};
+
+static std::vector<std::string> Split(const std::string& data, char separator) {
+    std::stringstream dataStream(data);
+    std::string segment;
+    std::vector<std::string> segmentList;
+
+    while (std::getline(dataStream, segment, separator)) {
+        if (!segment.empty()) {
+            segmentList.push_back(segment);
+        }
+    }
+    return segmentList;
+}
+
+static void LegacyParseFace(LegacyWavefront& data, const std::vector<std::string>& segmentList) {
+    for (const std::string& corner : segmentList) {
+        std::vector<std::string> subSegmentList = Split(corner, '/');
+
+        for (size_t k = 0; k < subSegmentList.size(); k++) {
+            switch (k) {
+            case 0: data.PositionIndices.push_back(std::stoi(subSegmentList[0]) - 1); break;
+            case 1: data.TextureCoordIndices.push_back(std::stoi(subSegmentList[1]) - 1); break;
+            case 2: data.NormalIndices.push_back(std::stoi(subSegmentList[2]) - 1); break;
+            default: break;
+            }
+        }
+    }
+}
+
+static bool LegacyLoadWavefront(const char* path, LegacyWavefront& data) {
+    /* The parser CreateStaticMeshFromWavefront had before LoadWavefront: the file through a stringstream, then
+    getline, std::string, substr, another stringstream and std::stof or std::stoi for every number. It stops at the
+    end of the file rather than running on to its old 0xffff iteration limit. */
+
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    std::stringstream stream;
+    stream << file.rdbuf();
+
+    char lineBuffer[512];
+
+    while (stream.getline(lineBuffer, sizeof(lineBuffer))) {
+        std::string line(lineBuffer);
+
+        if (line.size() < 2) {
+            continue;
+        }
+
+        if (line[0] == 'v' && line[1] == ' ') {
+            std::vector<std::string> values = Split(line.substr(2), ' ');
+            data.Positions.push_back(Vector3{ std::stof(values[0]), std::stof(values[1]), std::stof(values[2]) });
+        }
+        else if (line[0] == 'v' && line[1] == 't') {
+            std::vector<std::string> values = Split(line.substr(3), ' ');
+            data.TextureCoords.push_back(Vector2{ std::stof(values[0]), std::stof(values[1]) });
+        }
+        else if (line[0] == 'v' && line[1] == 'n') {
+            std::vector<std::string> values = Split(line.substr(3), ' ');
+            data.Normals.push_back(Vector3{ std::stof(values[0]), std::stof(values[1]), std::stof(values[2]) });
+        }
+        else if (line[0] == 'f') {
+            std::vector<std::string> corners = Split(line.substr(2), ' ');
+
+            if (corners.size() == 4) {
+                LegacyParseFace(data, { corners[0], corners[1], corners[2] });
+                LegacyParseFace(data, { corners[2], corners[3], corners[0] });
+            }
+            else {
+                LegacyParseFace(data, corners);
+            }
+        }
+    }
+
+    return true;
+}
+
+
+static std::vector<std::string> DefaultFiles() {
+    /* WAVEFRONT_BENCH_FILES is the list of shipped meshes, separated by '|'. */
+
+    std::vector<std::string> files;
+#ifdef WAVEFRONT_BENCH_FILES
+    std::stringstream list(WAVEFRONT_BENCH_FILES);
+    std::string file;
+    while (std::getline(list, file, '|')) {
+        if (!file.empty()) {
+            files.push_back(file);
+        }
+    }
+#endif
+    return files;
+}
+
+static std::string GridWavefront(const uint32_t size) {
+    /* A size by size grid of quads with positions, texture coordinates and normals, split into a few materials.
+    Half the rows use negative indices, so the parallel merge has relative indices to fix up. */
+
+    std::string text;
+    char line[128];
+
+    text.reserve(static_cast<size_t>(size + 1) * (size + 1) * 96 + static_cast<size_t>(size) * size * 48);
+
+    for (uint32_t y = 0; y <= size; y++) {
+        for (uint32_t x = 0; x <= size; x++) {
+            const float u = static_cast<float>(x) / size;
+            const float v = static_cast<float>(y) / size;
+
+            snprintf(line, sizeof(line), "v %.6f %.6f %.6f\nvt %.6f %.6f\nvn 0.0 1.0 0.0\n", u * 100.0f - 50.0f, 0.25f * u * v, v * 100.0f - 50.0f, u, v);
+            text += line;
+        }
+    }
+
+    for (uint32_t y = 0; y < size; y++) {
+        if (y % (size / 4 + 1) == 0) {
+            snprintf(line, sizeof(line), "usemtl Material.%03u\n", y / (size / 4 + 1));
+            text += line;
+        }
+
+        for (uint32_t x = 0; x < size; x++) {
+            const long corner = static_cast<long>(y * (size + 1) + x + 1);
+            const long count = static_cast<long>((size + 1) * (size + 1));
+            const long offset = (y % 2 == 0) ? 0 : -(count + 1);
+            const long a = corner + offset;
+            const long b = corner + 1 + offset;
+            const long c = corner + size + 2 + offset;
+            const long d = corner + size + 1 + offset;
+
+            snprintf(line, sizeof(line), "f %ld/%ld/%ld %ld/%ld/%ld %ld/%ld/%ld %ld/%ld/%ld\n", a, a, a, b, b, b, c, c, c, d, d, d);
+            text += line;
+        }
+    }
+
+    return text;
+}
+
+template<typename Function> static BenchResult TimeLoads(const uint32_t passes, Function function) {
+    BenchCounters counters;
+    BenchResult result;
+
+    for (uint32_t p = 0; p < passes; p++) {
+        counters.Start();
+        function();
+        result.Add(counters.Stop());
+    }
+
+    return result;
+}
+
+
+int main(int argc, char** argv) {
+
+    const uint32_t passes = (argc > 1) ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 20;
+    std::vector<std::string> files = (argc > 2) ? std::vector<std::string>(argv + 2, argv + argc) : DefaultFiles();
+
+    if (passes == 0 || files.empty()) {
+        printf("Usage: WavefrontBench [passes] [file.obj ...]\n");
+        return 1;
+    }
+
+    for (const std::string& path : files) {
+        LegacyWavefront legacy;
+        WavefrontData data;
+
+        if (!LegacyLoadWavefront(path.c_str(), legacy) || !LoadWavefront(path.c_str(), data)) {
+            printf("WavefrontBench: Could not load %s\n", path.c_str());
+            return 1;
+        }
+
+        // The two should agree on what is in the file.
+        const bool match = legacy.Positions.size() == data.Positions.size() && legacy.Normals.size() == data.Normals.size()
+            && legacy.TextureCoords.size() == data.TextureCoords.size() && legacy.PositionIndices.size() == data.PositionIndices.size();
+
+        const BenchResult legacyResult = TimeLoads(passes, [&]() {
+            LegacyWavefront reload;
+            LegacyLoadWavefront(path.c_str(), reload);
+        });
+
+        const BenchResult mappedResult = TimeLoads(passes, [&]() {
+            WavefrontData reload;
+            LoadWavefront(path.c_str(), reload);
+        });
+
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+
+        const BenchResult verticesResult = TimeLoads(passes, [&]() {
+            BuildWavefrontVertices(data, vertices, indices);
+        });
+
+        const char* name = strrchr(path.c_str(), '/');
+        name = (name == nullptr) ? path.c_str() : name + 1;
+
+        // Everything CreateStaticMeshFromWavefront does before the upload, from the text or from the cache.
+        MeshCacheSource source;
+        GetFileInfo(path.c_str(), source.Size, source.ModifiedTime);
+
+        const std::string cachePath = MeshCachePath(name);
+        const bool written = WriteMeshCache(cachePath.c_str(), source, data.Name, vertices.data(), vertices.size(), indices.data(), sizeof(uint32_t), indices.size(),
+            data.SurfaceIndexCounts.data(), data.SurfaceIndexCounts.size());
+
+        const BenchResult parseResult = TimeLoads(passes, [&]() {
+            WavefrontData reload;
+            LoadWavefront(path.c_str(), reload);
+            BuildWavefrontVertices(reload, vertices, indices);
+        });
+
+        bool cacheMatch = written;
+        const BenchResult cacheResult = TimeLoads(passes, [&]() {
+            MeshCacheData cache;
+            cacheMatch = LoadMeshCache(cachePath.c_str(), path.c_str(), cache) && cache.VertexCount == vertices.size() && cache.IndexCount == indices.size()
+                && memcmp(cache.Vertices, vertices.data(), vertices.size() * sizeof(Vertex)) == 0 && cacheMatch;
+        });
+
+        const double legacyMilliseconds = legacyResult.BestNanoseconds * 1e-6;
+        const double mappedMilliseconds = mappedResult.BestNanoseconds * 1e-6;
+
+        printf("{\"bench\":\"wavefront\",\"file\":\"%s\",\"vertices\":%zu,\"triangles\":%zu,\"match\":%s,", name, data.Positions.size(), data.PositionIndices.size() / 3, match ? "true" : "false");
+        printf("\"legacy_best_ms\":%.3f,\"mapped_best_ms\":%.3f,\"speedup\":%.1f,", legacyMilliseconds, mappedMilliseconds, legacyMilliseconds / (mappedMilliseconds == 0.0 ? 1.0 : mappedMilliseconds));
+        printf("\"unique_vertices\":%zu,\"vertex_bytes\":%zu,\"build_vertices_best_ms\":%.3f,", vertices.size(), vertices.size() * sizeof(Vertex), verticesResult.BestNanoseconds * 1e-6);
+        printf("\"cache_match\":%s,\"parse_and_build_best_ms\":%.3f,\"cache_best_ms\":%.3f}\n", cacheMatch ? "true" : "false", parseResult.BestNanoseconds * 1e-6, cacheResult.BestNanoseconds * 1e-6);
+    }
+
+    // Scaling over threads. The work is the same for every thread count, only how it is split changes.
+    const std::string grid = GridWavefront(600);
+    const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    double baseMilliseconds = 0.0;
+
+    for (uint32_t threads = 1;; threads = std::min(threads * 2, hardwareThreads)) {
+        JobSystem jobs(threads);
+        WavefrontData data;
+
+        const BenchResult result = TimeLoads(passes, [&]() {
+            ParseWavefront(grid.data(), grid.size(), data, &jobs);
+        });
+
+        const double milliseconds = result.BestNanoseconds * 1e-6;
+        baseMilliseconds = (threads == 1) ? milliseconds : baseMilliseconds;
+
+        printf("{\"bench\":\"wavefront_parallel\",\"megabytes\":%.1f,\"threads\":%u,\"vertices\":%zu,\"triangles\":%zu,", grid.size() / 1048576.0, threads, data.Positions.size(), data.PositionIndices.size() / 3);
+        printf("\"best_ms\":%.3f,\"megabytes_per_second\":%.1f,\"speedup\":%.2f}\n", milliseconds, grid.size() / 1048576.0 / (milliseconds * 1e-3), baseMilliseconds / milliseconds);
+
+        if (threads == hardwareThreads) {
+            break;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+// Pool memory starts on a cache line so the first element doesn't share one with whatever malloc put before it.
+#define POOL_CACHE_LINE 64
+
+
+inline void* AllocateAligned(uint64_t size, uint64_t alignment) {
+    /* malloc only promises 16 byte alignment. alignment must be a power of two, at least the size of a pointer. */
+#if defined(_WIN32)
+    return _aligned_malloc(size, alignment);
+#else
+    void* memory = nullptr;
+    return (posix_memalign(&memory, alignment, size) == 0) ? memory : nullptr;
+#endif
+}
+
+inline void FreeAligned(void* memory) {
+#if defined(_WIN32)
+    _aligned_free(memory);
+#else
+    free(memory);
+#endif
+}
@@ -1,25 +1,37 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <new>
+#include <utility>
 #include "vectorMath.h"
+#include "transform.h"
+#include "assetPool.h"
 
 // For these macros, the cast to uint8_t then back to void is kind of nasty but it *should* optimize out in the compiler.
 // Since it's not getting moved from a general purpose register to a floating point register, it's probably fine. probably.
 
 // Standard Buffer Size is the maximum size any alias can be.
 #define STANDARD_BUFFER_SIZE = 36
-#define ASSET_IS_MIN_TYPE(Asset)  ((*(((uint8_t*)Asset) + 45)) == 0xff)
-#define ASSET_IS_TYPE(Asset, Type) ((*(((uint8_t*)Asset) + 45)) == Type)
-#define GET_ASSET_TRANSFORM(Asset) ((Matrix*)(((uint8_t*)Asset) + 48))
-#define GET_ASSET_PARENT(Asset) ((void*)(((uint8_t*)Asset) + 112))
+// These read an asset through a pointer. Code that keeps an asset around should hold its AssetHandle instead, see
+// CreateAsset, and use the handle functions at the bottom of this file.
+#define ASSET_IS_MIN_TYPE(Asset)  ((*(((uint8_t*)Asset) + 36)) == 0xff)
+#define ASSET_IS_TYPE(Asset, Type) ((*(((uint8_t*)Asset) + 36)) == Type)
+#define GET_ASSET_TRANSFORM_HANDLE(Asset) (*(TransformHandle*)(((uint8_t*)Asset) + 48))
+#define GET_ASSET_TRANSFORM(Asset) (GetTransformStore().GetLocalMatrix(GET_ASSET_TRANSFORM_HANDLE(Asset)))
+#define SET_ASSET_TRANSFORM(Asset, Local) (GetTransformStore().SetLocal(GET_ASSET_TRANSFORM_HANDLE(Asset), Local))
+#define GET_ASSET_HANDLE(Asset) (*(AssetHandle*)(((uint8_t*)Asset) + 52))
+#define GET_ASSET_PARENT(Asset) (*(AssetHandle*)(((uint8_t*)Asset) + 56))
+#define GET_ASSET_FIRST_CHILD(Asset) (*(AssetHandle*)(((uint8_t*)Asset) + 60))
+#define GET_ASSET_NEXT_SIBLING(Asset) (*(AssetHandle*)(((uint8_t*)Asset) + 64))
 
 typedef struct min_asset {
     // Minimum Asset Definition, 48 bytes long. Only stores the alias, references, type and flags.
     #define MIN_ASSET_BODY()\
     char Alias[36]{'\0'};               /* 0    |   36      <--+-- These will be the same for any managed object.             */  \
-    uint64_t References = 0;            /* 36   |   8       <-/                                                               */  \
-    union Data {uint8_t Type = 0xff;    /* 44   |   x           _- Only use the upper 24 bits, the first 8 represent type.    */  \
-    uint32_t Flags;};                   /* 44   |   4       <--+-- General purpose bit flags. useful for keeping object state.*/  \
+    union {uint8_t Type = 0xff;         /* 36   |   x           _- Only use the upper 24 bits, the first 8 represent type.    */  \
+    uint32_t Flags;};                   /* 36   |   4       <--+-- General purpose bit flags. useful for keeping object state.*/  \
+    uint64_t References = 0;            /* 40   |   8                                                                         */  \
 
     MIN_ASSET_BODY()
 
@@ -30,24 +42,36 @@ typedef struct asset {
     // Holds basic information that all objects in a scene will have. Instead of using inheritance & polymorphism, which has some 
     // overhead, pass objects as void* then static cast to the actual type. This has some advantages in that any generic operation, 
     // like moving, rotating, scaling, etc can be done without a class-specific override. This also allows for more frequent cache hits
-    // because the data for an asset is always going to be exactly 128 bytes
+    // because the data for an asset is always going to be exactly 72 bytes. The transform itself lives in the TransformStore, so 
+    // passes over every transform don't have to load the rest of the asset.
+    //
+    // Assets live in one AssetPool per type and can move around inside it, so links to other assets are AssetHandles
+    // rather than pointers. Children are a linked list: the parent holds its first child, and each child the next one.
     //
     // The union is used because by default, the c preprocessor will try to pack things into 4 bytes. 
     //
     //                                  Offset  | Size in bytes    
     #define ASSET_BODY(type)\
+    static const uint8_t AssetType = type;                                                                                    \
     char Alias[36]{'\0'};               /* 0    |   36      <--+-- These will be the same for any managed object.             */  \
-    uint64_t References = 0;            /* 36   |   8       <-/                                                               */  \
-    union Data {uint8_t Type = type;    /* 44   |   x           _- Only use the upper 24 bits, the first 8 represent type.    */  \
-    uint32_t Flags;};                   /* 44   |   4       <--+-- General purpose bit flags. useful for keeping object state.*/  \
-    Matrix Transform = MatrixIdentity();/* 48   |   64      <----- 4 * 4 matrix, represents the local position.               */  \
-    void* Parent = nullptr;             /* 112  |   8       <----- pointer to the parent node.                                */  \
-    void** Children = nullptr;          /* 120  |   8       <----- pointer to array of child nodes.                           */  \
+    union {uint8_t Type = type;         /* 36   |   x           _- Only use the upper 24 bits, the first 8 represent type.    */  \
+    uint32_t Flags;};                   /* 36   |   4       <--+-- General purpose bit flags. useful for keeping object state.*/  \
+    uint64_t References = 0;            /* 40   |   8                                                                         */  \
+    AssetTransform Transform;           /* 48   |   4       <----- handle to the local position in the TransformStore.        */  \
+    AssetHandle Handle = INVALID_ASSET_HANDLE;      /* 52   |   4   <----- this asset's own handle.                           */  \
+    AssetHandle Parent = INVALID_ASSET_HANDLE;      /* 56   |   4   <----- handle to the parent node.                         */  \
+    AssetHandle FirstChild = INVALID_ASSET_HANDLE;  /* 60   |   4   <----- handle to the first child node.                    */  \
+    AssetHandle NextSibling = INVALID_ASSET_HANDLE; /* 64   |   4   <----- handle to the parent's next child.                 */  \
     
     ASSET_BODY(0x01);
 
 } asset;
 
+// The macros above read these offsets directly.
+static_assert(offsetof(asset, Type) == 36 && offsetof(min_asset, Type) == 36, "Asset type must be at offset 36.");
+static_assert(offsetof(asset, Transform) == 48 && offsetof(asset, Handle) == 52, "Asset transform and handle must be at offsets 48 and 52.");
+static_assert(offsetof(asset, Parent) == 56 && offsetof(asset, FirstChild) == 60 && offsetof(asset, NextSibling) == 64, "Asset links must be at offsets 56 to 64.");
+
 
 namespace ObjectType {
     const uint8_t Minimum       = 0xff; 
@@ -56,6 +80,11 @@ namespace ObjectType {
     const uint8_t SkinnedMesh   = 0x03;
     const uint8_t Text          = 0x04;
     const uint8_t Camera        = 0x05;
+
+    // Not assets, but their SlabPools register stats under these.
+    const uint8_t Material      = 0x06;
+    const uint8_t Font          = 0x07;
+    const uint8_t Texture       = 0x08;
 }
 
 
@@ -73,20 +102,60 @@ inline void SetAlias(void* gameObject, const char* string) {
 
 
 inline Matrix GetGlobalTransform(void* gameObject){
-    /* This function returns the global transform of any asset. */ 
-    Matrix result = MatrixIdentity() * *GET_ASSET_TRANSFORM(gameObject);
-    void* parentObject;
-    
-    for(uint16_t i = 0; i < 512; i++) {
-        parentObject = GET_ASSET_PARENT(gameObject);
-        
-        if(parentObject == nullptr) {
-            return result;
-        }
+    /* This function returns the global transform of any asset. Uses the cached world matrix unless the asset or one
+    of its parents has moved since the last UpdateTransforms. */ 
+    return GetTransformStore().GetGlobalMatrix(GET_ASSET_TRANSFORM_HANDLE(gameObject));
+}
+
+
+template<typename T> AssetPool& GetAssetPool() {
+    /* The pool for one asset type, created the first time it's needed. */
+    static AssetPool pool(T::AssetType, sizeof(T), [](void* asset) { static_cast<T*>(asset)->~T(); });
+    return pool;
+}
+
+template<typename T, typename... Args> T* CreateAsset(Args&&... args) {
+    /* Construct an asset in its type's pool. The pointer is only valid until the next asset of the same type is
+    created or destroyed, keep asset->Handle to find it again later. */
+
+    AssetHandle handle;
+    void* memory = GetAssetPool<T>().Allocate(handle);
 
-        result = result * *GET_ASSET_TRANSFORM(parentObject);
+    if (memory == nullptr) {
+        return nullptr;
     }
-    return result;
+
+    T* asset = new (memory) T(std::forward<Args>(args)...);
+    asset->Handle = handle;
+    return asset;
+}
+
+template<typename T> T* GetAsset(AssetHandle handle) {
+    /* Returns nullptr if the asset was destroyed or is not a T. */
+    return static_cast<T*>(GetAssetPool<T>().Get(handle));
 }
 
+template<typename T, typename Function> void ForEachAsset(Function function) {
+    /* Call function(T*) on every asset of one type, in the order they sit in memory. Don't create or destroy assets
+    of the same type from inside the loop. */
+
+    AssetPool& pool = GetAssetPool<T>();
+    for (uint32_t i = 0; i < pool.Count(); i++) {
+        function(static_cast<T*>(pool.GetDense(i)));
+    }
+}
+
+inline uint8_t GetAssetType(AssetHandle handle) {
+    // The type is stored in the handle, so this doesn't need to touch the asset.
+    return static_cast<uint8_t>(ASSET_HANDLE_TYPE(handle));
+}
+
+// Untyped versions, for code that works on any kind of asset.
+void* GetAsset(AssetHandle handle);
+bool DestroyAsset(AssetHandle handle);
+
+// Parent one asset to another, or pass INVALID_ASSET_HANDLE to make it a root. Keeps the transform hierarchy in sync.
+bool SetParent(AssetHandle child, AssetHandle parent);
+Matrix GetGlobalTransform(AssetHandle handle);
+
 
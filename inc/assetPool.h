@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "alignedAlloc.h"
+
+// Handles are 32 bits: the slot in the pool's handle table, how many times that slot has been reused, and the asset's
+// ObjectType. A handle whose generation doesn't match the slot's refers to an asset that has been destroyed.
+typedef uint32_t AssetHandle;
+
+#define INVALID_ASSET_HANDLE 0
+#define ASSET_HANDLE_INDEX_BITS 20
+#define ASSET_HANDLE_MAX_INDEX ((1u << ASSET_HANDLE_INDEX_BITS) - 1)
+#define ASSET_HANDLE_INDEX(Handle) ((Handle) & ASSET_HANDLE_MAX_INDEX)
+#define ASSET_HANDLE_GENERATION(Handle) (((Handle) >> ASSET_HANDLE_INDEX_BITS) & 0xFF)
+#define ASSET_HANDLE_TYPE(Handle) (((Handle) >> 28) & 0x0F)
+#define MAKE_ASSET_HANDLE(Type, Generation, Index) ((((AssetHandle)(Type) & 0x0F) << 28) | (((AssetHandle)(Generation) & 0xFF) << ASSET_HANDLE_INDEX_BITS) | ((AssetHandle)(Index) & ASSET_HANDLE_MAX_INDEX))
+
+// One pool per ObjectType, which fit in the 4 type bits of a handle.
+#define ASSET_POOL_TYPES 16
+
+
+struct PoolStats {
+    /* Allocation counters for one pool, read by telemetry through GetPoolStats. */
+
+    uint8_t Type = 0;
+    uint32_t ElementSize = 0;
+
+    uint64_t Live = 0;              // Elements allocated right now.
+    uint64_t Peak = 0;              // Highest Live has been.
+    uint64_t Capacity = 0;          // Elements that fit before the pool has to allocate again.
+    uint64_t Allocations = 0;       // Every Allocate since the pool was created.
+    uint64_t Frees = 0;
+    uint64_t BytesReserved = 0;     // Memory allocated for element storage.
+
+    void CountAllocation() {
+        Allocations++;
+        Live++;
+        Peak = (Live > Peak) ? Live : Peak;
+    }
+
+    void CountFree() {
+        Frees++;
+        Live--;
+    }
+};
+
+
+class AssetPool {
+    /* Dense storage for every asset of one type.
+
+    Assets sit back to back in one cache line aligned block, so a loop over every mesh or camera walks memory in order. Destroying
+    an asset moves the last one into its place, and growing the pool moves all of them, so pointers to assets only
+    stay valid until the next Allocate or Free on the same pool. Anything kept longer should be an AssetHandle, which
+    goes through a handle table and survives the move.
+
+    Assets are moved with memcpy. They must not hold pointers into themselves, which is true for everything built
+    from ASSET_BODY.
+
+    This class doesn't know the asset type. CreateAsset and DestroyAsset in asset.h construct and destruct them. */
+
+public:
+
+    typedef void (*DestructorFunction)(void* asset);
+
+    AssetPool(uint8_t type, uint32_t elementSize, DestructorFunction destructor);
+    ~AssetPool();
+
+    AssetPool(const AssetPool&) = delete;
+    AssetPool& operator=(const AssetPool&) = delete;
+
+    // Reserve memory for a new asset at the end of the pool. The caller constructs the asset in it.
+    void* Allocate(AssetHandle& outHandle);
+
+    // Destruct the asset and close the gap. Returns false if the handle is stale.
+    bool Free(AssetHandle handle);
+
+    // Returns nullptr if the handle is stale or belongs to another pool.
+    void* Get(AssetHandle handle) const;
+    bool IsValid(AssetHandle handle) const;
+
+    uint32_t Count() const { return AssetCount; }
+    const PoolStats& GetStats() const { return Stats; }
+    void* GetDense(uint32_t index) const { return Data + static_cast<uint64_t>(index) * ElementSize; }
+    AssetHandle GetDenseHandle(uint32_t index) const;
+
+    const uint8_t Type;
+    const uint32_t ElementSize;
+
+private:
+
+    uint8_t* Data;
+    uint32_t AssetCount;
+    uint32_t Capacity;
+    DestructorFunction Destructor;
+
+    // Per handle slot: the asset's dense index, or the next free slot if unused, and the slot's generation.
+    std::vector<uint32_t> Sparse;
+    std::vector<uint8_t> Generations;
+    std::vector<uint32_t> DenseToSlot;
+    uint32_t FreeHead;
+
+    PoolStats Stats;
+
+    void Grow();
+};
+
+
+// The pool registered for a type, or nullptr if no asset of that type has been created yet.
+AssetPool* FindAssetPool(uint8_t type);
+
+// Every pool, AssetPool or SlabPool, registers its stats under its ObjectType. Returns nullptr for a type with no pool.
+void RegisterPoolStats(uint8_t type, const PoolStats* stats);
+const PoolStats* GetPoolStats(uint8_t type);
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include "alignedAlloc.h"
+#include "hashTable.h"
+
+// Number of independent shards. Writers only block other writers on the same shard.
+#define CONCURRENT_HASH_TABLE_SHARDS 16
+
+
+template<typename T> class ConcurrentHashTable {
+    /* Hash table for data that is read from many threads and written rarely, like asset registries.
+
+    Each shard holds an immutable HashTable snapshot. Find never takes a lock, it just loads the current snapshot
+    and probes it. Writers lock their shard, build a new snapshot with the change applied, and swap it in. The old
+    snapshot is freed once every reader that might still be using it has left (a simple two counter RCU scheme).
+    Every shard tracks its own readers on its own cache line, so readers of different shards never touch the same
+    counters.
+
+    This makes writes cost O(items in the shard), which is fine for tables that are filled while loading and then
+    mostly read. Values are not protected once Find returns them, the same as with HashTable. */
+
+    struct ConcurrentHashTableItem {
+        T* Value;
+        bool isManaged;
+    };
+
+    // Every snapshot owns its own copies of the items, inserted as managed so HashTable frees them along with it.
+    typedef HashTable<ConcurrentHashTableItem> Snapshot;
+
+    struct alignas(POOL_CACHE_LINE) Shard {
+        std::atomic<Snapshot*> Table;
+        std::mutex WriteLock;
+
+        // Reader tracking. Readers count themselves under the parity of the epoch they entered in.
+        std::atomic<uint64_t> Epoch;
+        std::atomic<uint64_t> Readers[2];
+    };
+
+public:
+
+    ConcurrentHashTable(uint64_t size) {
+        uint64_t shardSize = size / CONCURRENT_HASH_TABLE_SHARDS;
+
+        for (uint64_t i = 0; i < CONCURRENT_HASH_TABLE_SHARDS; i++) {
+            Shards[i].Table.store(new Snapshot(shardSize), std::memory_order_relaxed);
+            Shards[i].Epoch.store(0);
+            Shards[i].Readers[0].store(0);
+            Shards[i].Readers[1].store(0);
+        }
+    }
+
+    // Shards are cache line aligned, which plain new doesn't promise before C++17.
+    static void* operator new(size_t size) {
+        void* memory = AllocateAligned(size, POOL_CACHE_LINE);
+        if (memory == nullptr) {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    static void operator delete(void* memory) {
+        FreeAligned(memory);
+    }
+
+    ~ConcurrentHashTable() {
+        /* Must not be called while other threads are still using the table. */
+
+        for (uint64_t i = 0; i < CONCURRENT_HASH_TABLE_SHARDS; i++) {
+            Snapshot* table = Shards[i].Table.load(std::memory_order_relaxed);
+
+            for (uint64_t slot = 0; slot < table->Size; slot++) {
+
+                // If the item is managed, (Dangling Pointer) delete it.
+                if (table->SlotUsed(slot) && table->Array[slot].Value->isManaged) {
+                    delete table->Array[slot].Value->Value;
+                }
+            }
+
+            delete table;
+        }
+    }
+
+    bool Find(const char* key, T*& outValue) {
+        return Find(StringId(key), outValue);
+    }
+
+    bool Find(const StringId& key, T*& outValue) {
+        /* Lock free. Safe to call from any thread, at the same time as writers. */
+
+        Shard& shard = GetShard(key);
+        const uint64_t epoch = EnterRead(shard);
+
+        Snapshot* table = shard.Table.load(std::memory_order_acquire);
+        ConcurrentHashTableItem* item = nullptr;
+        bool found = table->Find(key, item);
+
+        if (found) {
+            outValue = item->Value;
+        }
+
+        ExitRead(shard, epoch);
+        return found;
+    }
+
+    bool Insert(const char* key, T* value, bool isManaged = false) {
+        return Insert(StringId(key), value, isManaged);
+    }
+
+    bool Insert(const StringId& key, T* value, bool isManaged = false) {
+        /* Insert an item into the table. isManaged has the same meaning as in HashTable::Insert.
+
+        Unlike HashTable, this does not insert duplicates. If the key already exists, returns false and the table
+        does not take the value. This lets two loader threads race to register the same asset safely. */
+
+        Shard& shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.WriteLock);
+
+        Snapshot* current = shard.Table.load(std::memory_order_relaxed);
+        ConcurrentHashTableItem* existing = nullptr;
+
+        if (current->Find(key, existing)) {
+            return false;
+        }
+
+        Snapshot* next = CopySnapshot(current, current->SlotsUsed + 1, nullptr);
+        next->Insert(key, new ConcurrentHashTableItem{ value, isManaged }, true);
+
+        Publish(shard, next);
+        delete current;
+        return true;
+    }
+
+    bool Delete(const char* key) {
+        return Delete(StringId(key));
+    }
+
+    bool Delete(const StringId& key) {
+
+        Shard& shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.WriteLock);
+
+        Snapshot* current = shard.Table.load(std::memory_order_relaxed);
+        ConcurrentHashTableItem* existing = nullptr;
+
+        if (!current->Find(key, existing)) {
+            return false;
+        }
+
+        Snapshot* next = CopySnapshot(current, current->SlotsUsed, &key);
+        Publish(shard, next);
+
+        // If the item is managed, the table owns it, delete it. Same as HashTable::Delete.
+        if (existing->isManaged) {
+            delete existing->Value;
+        }
+
+        delete current;
+        return true;
+    }
+
+    bool Replace(const char* key, T* value) {
+        return Replace(StringId(key), value);
+    }
+
+    bool Replace(const StringId& key, T* value) {
+
+        Shard& shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.WriteLock);
+
+        Snapshot* current = shard.Table.load(std::memory_order_relaxed);
+        ConcurrentHashTableItem* existing = nullptr;
+
+        if (!current->Find(key, existing)) {
+            return false;
+        }
+
+        Snapshot* next = CopySnapshot(current, current->SlotsUsed, &key);
+        next->Insert(key, new ConcurrentHashTableItem{ value, existing->isManaged }, true);
+        Publish(shard, next);
+
+        // Same as HashTable::Replace, the old value is freed.
+        delete existing->Value;
+        delete current;
+        return true;
+    }
+
+    template<typename Function> void ForEach(Function function) {
+        /* Call function(const char* key, T* value, bool isManaged) for every item. Readers and writers can run
+        during this, but items added or removed while it runs may or may not be visited. */
+
+        for (uint64_t i = 0; i < CONCURRENT_HASH_TABLE_SHARDS; i++) {
+            const uint64_t epoch = EnterRead(Shards[i]);
+            Snapshot* table = Shards[i].Table.load(std::memory_order_acquire);
+
+            for (uint64_t slot = 0; slot < table->Size; slot++) {
+                if (table->SlotUsed(slot)) {
+                    ConcurrentHashTableItem* item = table->Array[slot].Value;
+                    function(table->GetKey(&table->Array[slot]), item->Value, item->isManaged);
+                }
+            }
+
+            ExitRead(Shards[i], epoch);
+        }
+    }
+
+private:
+
+    Shard Shards[CONCURRENT_HASH_TABLE_SHARDS];
+
+    Shard& GetShard(const StringId& key) {
+        // HashTable uses the low bits of the hash, so pick the shard from the top ones.
+        return Shards[(key.Hash >> 60) % CONCURRENT_HASH_TABLE_SHARDS];
+    }
+
+    uint64_t EnterRead(Shard& shard) {
+
+        for (;;) {
+            uint64_t epoch = shard.Epoch.load();
+            shard.Readers[epoch & 1].fetch_add(1);
+
+            // If a writer flipped the epoch before the count went up, it may not have waited for us. Try again.
+            if (shard.Epoch.load() == epoch) {
+                return epoch;
+            }
+            shard.Readers[epoch & 1].fetch_sub(1);
+        }
+    }
+
+    void ExitRead(Shard& shard, const uint64_t epoch) {
+        shard.Readers[epoch & 1].fetch_sub(1, std::memory_order_release);
+    }
+
+    void Publish(Shard& shard, Snapshot* next) {
+        /* Swap in a new snapshot, then wait until no reader can still be looking at the old one. Writers of a shard
+        hold its WriteLock, so only one of them flips its epoch at a time. */
+
+        shard.Table.store(next, std::memory_order_release);
+
+        uint64_t epoch = shard.Epoch.fetch_add(1);
+
+        while (shard.Readers[epoch & 1].load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    Snapshot* CopySnapshot(Snapshot* source, const uint64_t capacity, const StringId* skip) {
+        /* Copy every item except skip into a new snapshot with room for capacity items. Hashes are reused. */
+
+        Snapshot* copy = new Snapshot(capacity * 2);
+
+        for (uint64_t slot = 0; slot < source->Size; slot++) {
+
+            if (!source->SlotUsed(slot)) {
+                continue;
+            }
+
+            const char* key = source->GetKey(&source->Array[slot]);
+            const uint64_t keyLength = source->Array[slot].KeyLength;
+
+            if (skip != nullptr && skip->Hash == source->Array[slot].Hash && source->CompareKeys(&source->Array[slot], skip->String, skip->StringEnd)) {
+                continue;
+            }
+
+            copy->Insert(StringId(key, keyLength, source->Array[slot].Hash), new ConcurrentHashTableItem(*source->Array[slot].Value), true);
+        }
+
+        return copy;
+    }
+};
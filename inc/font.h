@@ -8,6 +8,7 @@ struct Material;
 struct Vector3;
 struct Vector2;
 struct Mesh;
+struct StringId;
 
 typedef struct Font {
 
@@ -30,6 +31,10 @@ typedef struct Font {
 	Font(Material* material, uint16_t charactersToLoad, uint16_t atlasSize);
 	~Font();
 
+	// Fonts live in a SlabPool, new and delete go through it.
+	static void* operator new(size_t size);
+	static void operator delete(void* font);
+
 } Font;
 
 typedef struct TextRender {
@@ -57,4 +62,5 @@ void DereferenceFonts();
 void DrawTextMesh(const TextRender* textRender, const Camera* camera, const double aspectRatio, const GLfloat time);
 
 void SetFont(TextRender* textRender, const char* fontName, Font* defaultFont = nullptr);
+void SetFont(TextRender* textRender, const StringId& fontName, Font* defaultFont = nullptr);
 void SetText(TextRender* textRender, const char* string, int x, int y, const float windowWidth, const float windowHeight, const float size);
@@ -1,12 +1,26 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
 #include <cstring>
+#include <new>
+#include <string>
+#include <type_traits>
 
+#include "alignedAlloc.h"
 
-inline uint64_t fnvHash64(const char* buffer, const char* const bufferEnd) {
+// SSE2 is part of the x86-64 baseline, so the group probe only falls back to scalar code on other targets.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HASH_TABLE_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+
+constexpr uint64_t fnvHash64(const char* buffer, const char* const bufferEnd) {
     /* implementation of the fnv64 hashing function, created by Glenn Fowler, Landon Curt Noll,
-    and Kiem-Phong Vo. I used fixed-width integers here for maximum portability. */
+    and Kiem-Phong Vo. I used fixed-width integers here for maximum portability. 
+    
+    This is constexpr so that string literals can be hashed by the compiler, see StringId. */
 
     const uint64_t Prime = 0x00000100000001B3;
     uint64_t Hash = 0xCBF29CE484222325;
@@ -21,7 +35,50 @@ inline uint64_t fnvHash64(const char* buffer, const char* const bufferEnd) {
     return Hash;
 }
 
-inline char* FindBufferEnd(const char* buffer) {
+constexpr uint64_t ReadWord64(const char* buffer) {
+    /* Little endian 8 byte load, written out byte by byte so it stays constexpr. GCC, Clang and MSVC all merge
+    this into a single load when it runs on the CPU. */
+
+    return static_cast<uint64_t>(static_cast<uint8_t>(buffer[0]))
+        | (static_cast<uint64_t>(static_cast<uint8_t>(buffer[1])) << 8)
+        | (static_cast<uint64_t>(static_cast<uint8_t>(buffer[2])) << 16)
+        | (static_cast<uint64_t>(static_cast<uint8_t>(buffer[3])) << 24)
+        | (static_cast<uint64_t>(static_cast<uint8_t>(buffer[4])) << 32)
+        | (static_cast<uint64_t>(static_cast<uint8_t>(buffer[5])) << 40)
+        | (static_cast<uint64_t>(static_cast<uint8_t>(buffer[6])) << 48)
+        | (static_cast<uint64_t>(static_cast<uint8_t>(buffer[7])) << 56);
+}
+
+constexpr uint64_t HashKey(const char* buffer, const char* const bufferEnd) {
+    /* Hash function used for HashTable keys. Works on 8 bytes at a time instead of fnvHash64's one, which 
+    matters for file path keys. The murmur3 finalizer at the end makes sure every input bit reaches the low 
+    bits, since those pick the control tag and the probe group. */
+
+    const uint64_t Multiplier = 0x9E3779B97F4A7C15;
+    const uint64_t length = static_cast<uint64_t>(bufferEnd - buffer);
+    uint64_t Hash = 0xCBF29CE484222325 ^ (length * Multiplier);
+
+    for (; bufferEnd - buffer >= 8; buffer += 8) {
+        Hash = (Hash ^ ReadWord64(buffer)) * Multiplier;
+        Hash ^= Hash >> 32;
+    }
+
+    // Pack the last 0 - 7 bytes into one word.
+    uint64_t tail = 0;
+    for (uint64_t shift = 0; buffer < bufferEnd; buffer++, shift += 8) {
+        tail |= static_cast<uint64_t>(static_cast<uint8_t>(*buffer)) << shift;
+    }
+    Hash = (Hash ^ tail) * Multiplier;
+
+    Hash ^= Hash >> 33;
+    Hash *= 0xFF51AFD7ED558CCD;
+    Hash ^= Hash >> 33;
+    Hash *= 0xC4CEB9FE1A85EC53;
+    Hash ^= Hash >> 33;
+    return Hash;
+}
+
+constexpr char* FindBufferEnd(const char* buffer) {
 
     char* bufferEnd = const_cast<char*>(buffer);
 
@@ -36,6 +93,39 @@ inline char* FindBufferEnd(const char* buffer) {
     return bufferEnd;
 }
 
+struct StringId {
+    /* A key with its end and hash already known. Passing one of these to a HashTable skips scanning for the
+    null terminator and hashing, which is most of the cost of a lookup on short keys.
+
+    Use STRING_ID("literal") to have the compiler compute the hash. Constructing one from a runtime string 
+    hashes it once, so it can be reused for a Find followed by an Insert. If the length is already known, 
+    pass it in (or pass the std::string) to skip the scan for the null terminator. The string is not copied,
+    and does not need to be null terminated when a length is given. */
+
+    const char* String;
+    const char* StringEnd;
+    uint64_t Hash;
+
+    constexpr StringId(const char* string) : String(string), StringEnd(FindBufferEnd(string)), Hash(HashKey(String, StringEnd)) { }
+    constexpr StringId(const char* string, const uint64_t length) : String(string), StringEnd(string + length), Hash(HashKey(String, StringEnd)) { }
+    StringId(const std::string& string) : String(string.data()), StringEnd(string.data() + string.size()), Hash(HashKey(String, StringEnd)) { }
+    constexpr StringId(const char* string, const uint64_t length, const uint64_t hash) : String(string), StringEnd(string + length), Hash(hash) { }
+};
+
+inline char* CopyString(const StringId& string) {
+    /* Allocate a null terminated copy of the string. Free it with delete[]. */
+
+    const uint64_t length = string.StringEnd - string.String;
+    char* copy = new char[length + 1];
+    memcpy(copy, string.String, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+// The integral_constant forces the hash to be evaluated at compile time, even in debug builds.
+#define STRING_ID(literal) StringId(literal, sizeof(literal) - 1, std::integral_constant<uint64_t, HashKey(literal, literal + sizeof(literal) - 1)>::value)
+
+
 template<typename T> T Pow2Ceiling(T num) {
     /* This function returns the next nearest power of 2 from the input number. */
 
@@ -52,268 +142,603 @@ template<typename T> T Pow2Ceiling(T num) {
 }
 
 
+namespace HashTableControl {
+    /* Control bytes for the hash table. Full slots store the low 7 bits of the hash (0x00 - 0x7F),
+    so the high bit being set means the slot does not hold a key. */
+    const int8_t Empty      = -128;     // 0x80, never used. Probing stops here.
+    const int8_t Deleted    = -2;       // 0xFE, tombstone. Probing continues past this.
+    const uint64_t GroupWidth = 16;     // Number of control bytes checked at once.
+}
+
+
+// Keys shorter than this are stored inside the slot. Matches the size of an asset alias.
+#define HASH_TABLE_INLINE_KEY_SIZE 36
+
+
+inline uint32_t MatchControlGroup(const int8_t* group, const int8_t value) {
+    /* Returns a bitmask where bit i is set if group[i] == value. */
+
+#ifdef HASH_TABLE_USE_SSE2
+    __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value))));
+#else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < HashTableControl::GroupWidth; i++) {
+        mask |= static_cast<uint32_t>(group[i] == value) << i;
+    }
+    return mask;
+#endif
+}
+
+inline uint32_t MatchControlGroupFree(const int8_t* group) {
+    /* Returns a bitmask where bit i is set if group[i] is Empty or Deleted. Both have the high bit set. */
+
+#ifdef HASH_TABLE_USE_SSE2
+    __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<uint32_t>(_mm_movemask_epi8(ctrl));
+#else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < HashTableControl::GroupWidth; i++) {
+        mask |= static_cast<uint32_t>(group[i] < 0) << i;
+    }
+    return mask;
+#endif
+}
+
+inline uint32_t LowestBitIndex(uint32_t mask) {
+    /* Index of the lowest set bit. mask must not be zero. */
+    assert(mask != 0);
+
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_ctz(mask));
+#else
+    uint32_t index = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+
 template<typename T> class HashTable {
-    /* Hash table with key indexing and dynamic resizing. */
+    /* Open addressing hash table with key indexing and dynamic resizing.
+
+    Each slot has a matching control byte in a separate array. The control byte holds a 7 bit tag from the key's 
+    hash, so a lookup compares 16 tags at once and only touches the item array when a tag matches. Deleted slots 
+    are marked with a tombstone instead of being cleared, which keeps probe chains intact for keys inserted after them. 
+    
+    Short keys are copied into the slot itself, so a lookup only has to touch the one item. Keys that don't fit are 
+    copied into a single string arena owned by the table, and the slot stores their offset into it. */
 
     struct HashTableItem {
-        /* An object in a hash table. */
-        char* Key;
-        char* KeyEnd;
+        /* An object in a hash table. Exactly one cache line when T* is 8 bytes. 
+        
+        This does not manage the value pointer.
+            
+        !!!! This is intentional !!!! 
+            
+        Please see HashTable Insert.
+        
+        */
+        uint64_t Hash;
         T* Value;
+        uint32_t KeyLength;
         bool isManaged;
-        uint64_t KeyLength;
 
-        inline HashTableItem() : Key(nullptr), KeyEnd(nullptr), Value(nullptr), KeyLength(0), isManaged(true) { }
+        union {
+            char Inline[HASH_TABLE_INLINE_KEY_SIZE];    // Used when KeyLength < HASH_TABLE_INLINE_KEY_SIZE.
+            uint64_t ArenaOffset;                       // Otherwise, where the key starts in KeyArena.
+        } Key;
 
-        inline ~HashTableItem() {
-            /* This function does not manage the value pointer.
-            
-            !!!! This is intentional !!!! 
-            
-            Please see HashTable Insert.
-
-            */
-            
-            if (Key != nullptr) {
-                delete[] Key;
-            }
-            
-            Key = nullptr;
-            KeyEnd = nullptr;
-            Value = nullptr;
-        }
+        inline HashTableItem() : Hash(0), Value(nullptr), KeyLength(0), isManaged(true) { Key.Inline[0] = '\0'; }
     };
 
 public:
 
-    HashTable(uint64_t size) {
+    HashTable(uint64_t size, bool incrementalResize = false) {
         Size = (size < 16) ? 16 : Pow2Ceiling<uint64_t>(size);
-        Array = new HashTable<T>::HashTableItem[Size];
+        Array = AllocateItems(Size);
+        Control = new int8_t[Size];
+        memset(Control, HashTableControl::Empty, Size);
         SlotsUsed = 0;
+        Tombstones = 0;
+
+        KeyArena = nullptr;
+        KeyArenaSize = 0;
+        KeyArenaUsed = 0;
+        KeyArenaGarbage = 0;
+
+        IncrementalResize = incrementalResize;
+        MigrationStep = 32;
+        MigrationWorstCase = 0;
+        OldSize = 0;
+        OldArray = nullptr;
+        OldControl = nullptr;
+        MigrationIndex = 0;
     }
 
     ~HashTable() {
 
-        for (uint64_t i = 0; i < Size; i++) {
-            
-            // If there is no value to delete, continue.
-            if (Array[i].Value == nullptr) {
-                continue;
-            }
-
-            // If the item is managed, (Dangling Pointer) delete it.
-            if (Array[i].isManaged) {
-                delete Array[i].Value;
-            }
+        FreeValues(Array, Control, Size);
+        FreeAligned(Array);
+        delete[] Control;
+        Array = nullptr;
+        Control = nullptr;
+
+        if (OldArray != nullptr) {
+            FreeValues(OldArray, OldControl, OldSize);
+            FreeAligned(OldArray);
+            delete[] OldControl;
+            OldArray = nullptr;
+            OldControl = nullptr;
         }
 
-        delete[] Array;
-        Array = nullptr;
+        delete[] KeyArena;
+        KeyArena = nullptr;
     }
 
     bool Replace(const char* key, T* Value) {
+        return Replace(StringId(key), Value);
+    }
 
-        char* keyEnd = FindBufferEnd(key);
-
-        // Generate the hash for the string.
-        uint64_t hash = fnvHash64(key, keyEnd) % Size;
-        uint64_t originalHash = hash;
-
-        while (Array[hash].Key != nullptr) {
+    bool Replace(const char* key, const uint64_t keyLength, T* Value) {
+        return Replace(StringId(key, keyLength), Value);
+    }
 
-            if (HashTable::CompareKeys(&Array[hash], key, keyEnd)) {
-                delete Array[hash].Value;
-                Array[hash].Value = Value;
-                return true;
-            }
+    bool Replace(const StringId& key, T* Value) {
 
-            hash++;
-            hash %= Size;
+        MigrateStep();
+        HashTableItem* item = FindItem(key);
 
-            if (originalHash == hash) {
-                return false;
-            }
+        if (item == nullptr) {
+            return false;
         }
-        return false;
+
+        delete item->Value;
+        item->Value = Value;
+        return true;
     }
 
     bool Find(const char* key, T*& outValue) {
+        return Find(StringId(key), outValue);
+    }
 
-        char* keyEnd = FindBufferEnd(key);
-
-        // Generate the hash for the string.
-        uint64_t hash = fnvHash64(key, keyEnd) % Size;
-        uint64_t originalHash = hash;
-
-        while (Array[hash].Key != nullptr) {
+    bool Find(const char* key, const uint64_t keyLength, T*& outValue) {
+        return Find(StringId(key, keyLength), outValue);
+    }
 
-            if (HashTable::CompareKeys(&Array[hash], key, keyEnd)) {
-                outValue = Array[hash].Value;
-                return true;
-            }
+    bool Find(const StringId& key, T*& outValue) {
 
-            hash++;
-            hash %= Size;
+        MigrateStep();
+        HashTableItem* item = FindItem(key);
 
-            if (originalHash == hash) {
-                return false;
-            }
+        if (item == nullptr) {
+            return false;
         }
-        return false;
+
+        outValue = item->Value;
+        return true;
     }
 
     bool Delete(const char* key) {
+        return Delete(StringId(key));
+    }
+
+    bool Delete(const char* key, const uint64_t keyLength) {
+        return Delete(StringId(key, keyLength));
+    }
 
-        char* keyEnd = FindBufferEnd(key);
+    bool Delete(const StringId& key) {
 
-        // Generate the hash for the string.
-        uint64_t hash = fnvHash64(key, keyEnd) % Size;
-        uint64_t originalHash = hash;
+        int8_t* control;
+        bool inOldArray;
+        HashTableItem* item = FindItem(key, &control, &inOldArray);
 
-        while (Array[hash].Key != nullptr) {
+        if (item == nullptr) {
+            return false;
+        }
 
-            if (HashTable::CompareKeys(&Array[hash], key, keyEnd)) {
-                // Free the key and mark it as null for reuse. 
-                delete[] Array[hash].Key;
-                Array[hash].Key = nullptr;
-                Array[hash].KeyEnd = nullptr;
-                
-                // If the item is not a managed resource, delete it.
-                if (!Array[hash].isManaged) {
-                    delete Array[hash].Value;
-                }
+        // Leave a tombstone so later probes keep walking past this slot. Long keys stay in the arena until it's compacted.
+        *control = HashTableControl::Deleted;
 
-                Array[hash].Value = nullptr;
-                Array[hash].isManaged = true;
-                SlotsUsed--;
-                return true;
-            }
+        if (item->KeyLength >= HASH_TABLE_INLINE_KEY_SIZE) {
+            KeyArenaGarbage += item->KeyLength + 1;
+        }
 
-            hash++;
-            hash %= Size;
+        // If the item is managed, the table owns it, delete it. Same as the destructor.
+        if (item->isManaged) {
+            delete item->Value;
+        }
 
-            if (originalHash == hash) {
-                return false;
-            }
+        item->Value = nullptr;
+        item->isManaged = true;
+        SlotsUsed--;
+
+        // Tombstones left in the old array are dropped when the migration finishes.
+        if (!inOldArray) {
+            Tombstones++;
         }
-        return false;
+        return true;
     }
 
-    char* Insert(const char* key, T* value, bool isManaged = false) {
-        /* Insert an item into the table, returns a pointer to the key. 
+    const char* Insert(const char* key, T* value, bool isManaged = false) {
+        return Insert(StringId(key), value, isManaged);
+    }
+
+    const char* Insert(const char* key, const uint64_t keyLength, T* value, bool isManaged = false) {
+        return Insert(StringId(key, keyLength), value, isManaged);
+    }
+
+    const char* Insert(const StringId& key, T* value, bool isManaged = false) {
+        /* Insert an item into the table, returns a pointer to the stored key. Keys move when the table is resized,
+        so the pointer is only valid until the table is next modified. Keep your own copy if you need one.
        
         The is managed value requires some explanation. This flag controls if the
         value T is a managed resource or not. Since T* values can be from either 
         the stack, the heap or statically declared, some values might need to be freed
-        when the HashTable gets destroyed while others do not.
+        when the HashTable gets destroyed while others do not. Managed values are deleted
+        by Delete and by the destructor, unmanaged ones are never touched.
         
         If you don't know what you're doing with this, leave it as false.
         
         */
 
-        // If there are no available slots, expand the table.
-        if (++SlotsUsed == Size) {
-            Expand();
-        }
+        MigrateStep();
 
-        char* keyEnd = FindBufferEnd(key);
+        // Keep at least 1/8th of the slots empty so that misses always terminate early. Tombstones count as used 
+        // here since they do not stop a probe. If most of the load is tombstones, rehash at the same size to clear them.
+        if ((++SlotsUsed + Tombstones) * 8 > Size * 7) {
+            if (SlotsUsed * 2 > Size) {
+                Expand();
+            }
+            else {
+                Rehash(Size);
+            }
+        }
 
-        // Generate the hash for the string.
-        uint64_t hash = fnvHash64(key, keyEnd) % Size;
-        uint64_t originalHash = hash;
+        const uint64_t keyLength = key.StringEnd - key.String;
+        uint64_t slot = FindFreeSlot(Control, Size, key.Hash);
+        char* storedKey;
 
-        // Check for collisions, linearly probe for a free slot.
-        while (Array[hash].Key != nullptr) {
-            hash++;
-            hash %= Size;
+        // Reserve arena space before the slot is marked full, since growing the arena can compact it.
+        if (keyLength < HASH_TABLE_INLINE_KEY_SIZE) {
+            storedKey = Array[slot].Key.Inline;
+        }
+        else {
+            Array[slot].Key.ArenaOffset = AllocateArenaKey(keyLength + 1);  // Must be KeyLength + 1 to account for the null terminator.
+            storedKey = KeyArena + Array[slot].Key.ArenaOffset;
+        }
 
-            if (originalHash == hash) {
-                // something went really wrong and an open slot could not be found.
-                assert(false);
-            }
+        if (Control[slot] == HashTableControl::Deleted) {
+            Tombstones--;
         }
 
-        // Found a free slot, create an item and store it there.
-       
-        // Trying to just override Array[hash] will cause the system to try to delete the new item after it falls out of scope, so doing this here now.
-        Array[hash].KeyLength = keyEnd - key;
-        
-        Array[hash].Key = new char[Array[hash].KeyLength + 1];  // Must be KeyLength + 1 to account for the null terminator.
-        
-        memcpy(Array[hash].Key, key, Array[hash].KeyLength + 1);
-        Array[hash].KeyEnd = Array[hash].Key + Array[hash].KeyLength;
-        Array[hash].Value = value;
+        // Found a free slot, store the item there.
+        Control[slot] = static_cast<int8_t>(key.Hash & 0x7F);
+        Array[slot].Hash = key.Hash;
+        Array[slot].KeyLength = static_cast<uint32_t>(keyLength);
+        Array[slot].Value = value;
+        Array[slot].isManaged = isManaged;
 
-        return Array[hash].Key;
+        memcpy(storedKey, key.String, keyLength);
+        storedKey[keyLength] = '\0';
+
+        return storedKey;
     }
 
     void Expand() {
-        /* This function is insanely expensive. Since the hashes are determined by the initial size,
-        everything needs to be recalculated. the size is set to the next nearest power of two to ensure
-        this doesn't happen often. */
+        /* Double the size of the table. The size is always a power of two to ensure this doesn't happen often. */
+        Rehash(Size << 1);
+    }
 
-        uint64_t newSize = Size << 1;   // double the size.
+    void Rehash(uint64_t newSize) {
+        /* Move every item into a new array of newSize slots. Hashes are stored with the items so the keys are not 
+        read again, and tombstones are dropped. 
+        
+        With IncrementalResize set, this only swaps in the new array. The old one stays alive and MigrationStep 
+        slots of it are moved over on each Insert, Find and Replace until it is empty. */
 
-        HashTable<T>::HashTableItem* Temp = new HashTable<T>::HashTableItem[newSize];
+        // Only one old array can be alive at a time.
+        FinishMigration();
 
-        for (uint64_t i = 0; i < Size; i++) {
+        OldArray = Array;
+        OldControl = Control;
+        OldSize = Size;
+        MigrationIndex = 0;
 
-            // if this slot was unused, skip it.
-            if (Array[i].Key == nullptr) {
-                continue;
-            }
+        Array = AllocateItems(newSize);
+        Control = new int8_t[newSize];
+        memset(Control, HashTableControl::Empty, newSize);
+        Size = newSize;
+        Tombstones = 0;
 
-            // Generate the hash for the item.
-            uint64_t hash = fnvHash64(Array[i].Key, Array[i].KeyEnd) % newSize;
-            uint64_t originalHash = hash;
+        if (!IncrementalResize) {
+            FinishMigration();
+        }
+    }
 
-            // Check for collisions, linearly probe for a free slot.
-            while (Temp[hash].Key != nullptr) {
-                hash++;
-                hash %= newSize;
+    void FinishMigration() {
+        /* Move everything left in the old array over in one go. Call this before iterating over Array directly. */
 
-                if (originalHash == hash) {
-                    // something went really wrong and an open slot could not be found.
-                    assert(false);
-                }
-            }
-            // Store the item from the old array in the temp one.
-            Temp[hash] = Array[i];
+        if (OldArray != nullptr) {
+            MigrateSlots(OldSize);
         }
+    }
 
-        delete[] Array;
-        Array = Temp;
-        Temp = nullptr;
-        Size = newSize;
+    bool IsMigrating() const {
+        return OldArray != nullptr;
+    }
+
+    bool SlotUsed(const uint64_t slot) const {
+        return Control[slot] >= 0;
+    }
+
+    const char* GetKey(const HashTableItem* item) const {
+        return (item->KeyLength < HASH_TABLE_INLINE_KEY_SIZE) ? item->Key.Inline : KeyArena + item->Key.ArenaOffset;
     }
 
     bool CompareKeys(const HashTableItem* item, const char* key, const char* keyEnd) {
         /* Basically the same as strcmp, the length check might be slightly faster. */ 
 
         // Leave early if the keys don't have the same length.
-        if (item->KeyLength != (keyEnd - key)) {
+        if (item->KeyLength != static_cast<uint64_t>(keyEnd - key)) {
             return false;
         }
 
         // since they ARE the same length, now compare the characters until a difference is found. Big O(n)
-        char* aIterator = item->Key;
-        char* bIterator = const_cast<char*>(key);
+        return memcmp(GetKey(item), key, item->KeyLength) == 0;
+    }
+    
+    uint64_t SlotsUsed;
+    uint64_t Tombstones;
+    uint64_t Size;
+    HashTableItem* Array;
+    int8_t* Control;
+
+    // Resize settings and stats:
+    bool IncrementalResize;         // Spread rehashing over later calls instead of blocking.
+    uint64_t MigrationStep;         // Number of old slots moved per call while migrating.
+    uint64_t MigrationWorstCase;    // Most items rehashed by a single call, blocking or not.
+
+private:
+
+    // Storage for keys too long to fit inline:
+    char* KeyArena;
+    uint64_t KeyArenaSize;
+    uint64_t KeyArenaUsed;
+    uint64_t KeyArenaGarbage;       // Bytes used by keys that have since been deleted.
+
+    uint64_t OldSize;
+    HashTableItem* OldArray;
+    int8_t* OldControl;
+    uint64_t MigrationIndex;        // Old slots before this index have been moved.
+
+    static HashTableItem* AllocateItems(const uint64_t count) {
+        /* Items start on a cache line, so each one fills exactly one instead of straddling two. Free with
+        FreeAligned, items have nothing to destroy. */
+
+        static_assert(std::is_trivially_destructible<HashTableItem>::value, "HashTable items are freed without destructors");
+
+        void* memory = AllocateAligned(count * sizeof(HashTableItem), POOL_CACHE_LINE);
+        if (memory == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        HashTableItem* items = static_cast<HashTableItem*>(memory);
+        for (uint64_t i = 0; i < count; i++) {
+            new (&items[i]) HashTableItem();
+        }
+        return items;
+    }
+
+    uint64_t AllocateArenaKey(const uint64_t bytes) {
+        /* Reserve bytes in the key arena and return the offset to them. */
+
+        if (KeyArenaUsed + bytes > KeyArenaSize) {
+
+            // If at least half the arena is dead keys, squeezing them out is cheaper than growing.
+            if (KeyArenaGarbage * 2 >= KeyArenaUsed && KeyArenaGarbage >= bytes) {
+                CompactArena();
+            }
+            else {
+                uint64_t newSize = (KeyArenaSize < 256) ? 256 : KeyArenaSize;
+                while (newSize < KeyArenaUsed + bytes) {
+                    newSize <<= 1;
+                }
+
+                char* newArena = new char[newSize];
+                if (KeyArena != nullptr) {
+                    memcpy(newArena, KeyArena, KeyArenaUsed);
+                }
+                delete[] KeyArena;
+                KeyArena = newArena;
+                KeyArenaSize = newSize;
+            }
+        }
+
+        uint64_t offset = KeyArenaUsed;
+        KeyArenaUsed += bytes;
+        return offset;
+    }
+
+    void CompactArena() {
+        /* Copy the live long keys into a fresh arena, in slot order. */
+
+        char* newArena = new char[KeyArenaSize];
+        uint64_t used = 0;
+
+        HashTableItem* arrays[2] = { Array, OldArray };
+        int8_t* controls[2] = { Control, OldControl };
+        uint64_t sizes[2] = { Size, OldSize };
+
+        for (int a = 0; a < 2; a++) {
+            for (uint64_t i = 0; i < sizes[a]; i++) {
+
+                if (controls[a][i] < 0 || arrays[a][i].KeyLength < HASH_TABLE_INLINE_KEY_SIZE) {
+                    continue;
+                }
+
+                const uint64_t bytes = arrays[a][i].KeyLength + 1;
+                memcpy(newArena + used, KeyArena + arrays[a][i].Key.ArenaOffset, bytes);
+                arrays[a][i].Key.ArenaOffset = used;
+                used += bytes;
+            }
+        }
+
+        delete[] KeyArena;
+        KeyArena = newArena;
+        KeyArenaUsed = used;
+        KeyArenaGarbage = 0;
+    }
+
+    void MigrateStep() {
+        /* Move the next few slots of the old array, if there is one. */
+
+        if (OldArray != nullptr) {
+            MigrateSlots(MigrationStep);
+        }
+    }
+
+    void MigrateSlots(uint64_t count) {
+        /* Move up to count slots from the old array into the current one, then free the old array once it's empty. */
+
+        uint64_t end = (OldSize - MigrationIndex < count) ? OldSize : MigrationIndex + count;
+        uint64_t moved = 0;
+
+        for (; MigrationIndex < end; MigrationIndex++) {
 
-        for (; aIterator < item->KeyEnd; aIterator++) {
+            // if this slot is empty or a tombstone, skip it.
+            if (OldControl[MigrationIndex] < 0) {
+                continue;
+            }
+
+            uint64_t slot = FindFreeSlot(Control, Size, OldArray[MigrationIndex].Hash);
+
+            if (Control[slot] == HashTableControl::Deleted) {
+                Tombstones--;
+            }
+
+            // Items are plain data, so moving one is a copy. Arena offsets stay valid since the arena is shared.
+            Control[slot] = OldControl[MigrationIndex];
+            Array[slot] = OldArray[MigrationIndex];
+
+            // Leave a tombstone behind so keys further along this probe chain can still be found in the old array.
+            OldControl[MigrationIndex] = HashTableControl::Deleted;
+            moved++;
+        }
+
+        if (moved > MigrationWorstCase) {
+            MigrationWorstCase = moved;
+        }
+
+        if (MigrationIndex == OldSize) {
+            FreeAligned(OldArray);
+            delete[] OldControl;
+            OldArray = nullptr;
+            OldControl = nullptr;
+            OldSize = 0;
+            MigrationIndex = 0;
+        }
+    }
+
+    void FreeValues(HashTableItem* array, const int8_t* control, const uint64_t size) {
+        
+        for (uint64_t i = 0; i < size; i++) {
+            
+            // If there is no value to delete, continue.
+            if (control[i] < 0 || array[i].Value == nullptr) {
+                continue;
+            }
+
+            // If the item is managed, (Dangling Pointer) delete it.
+            if (array[i].isManaged) {
+                delete array[i].Value;
+            }
+        }
+    }
+
+    HashTableItem* FindItem(const StringId& key, int8_t** outControl = nullptr, bool* outInOldArray = nullptr) {
+        /* Look for the key in the current array, then in the old one if a migration is in progress. */
+
+        uint64_t slot;
+
+        if (FindSlot(Array, Control, Size, key, slot)) {
+            if (outControl != nullptr) {
+                *outControl = &Control[slot];
+            }
+            if (outInOldArray != nullptr) {
+                *outInOldArray = false;
+            }
+            return &Array[slot];
+        }
+
+        if (OldArray != nullptr && FindSlot(OldArray, OldControl, OldSize, key, slot)) {
+            if (outControl != nullptr) {
+                *outControl = &OldControl[slot];
+            }
+            if (outInOldArray != nullptr) {
+                *outInOldArray = true;
+            }
+            return &OldArray[slot];
+        }
+
+        return nullptr;
+    }
+
+    bool FindSlot(const HashTableItem* array, const int8_t* control, const uint64_t size, const StringId& key, uint64_t& outSlot) {
+        /* Probe the table one group of control bytes at a time. Returns true and sets outSlot if the key exists. */
 
-            // If the value at bIterator is not the same as the one in aIterator, the keys are different.
-            if (*bIterator != *aIterator) {
+        const uint64_t hash = key.Hash;
+        const uint64_t groupMask = (size / HashTableControl::GroupWidth) - 1;
+        const int8_t tag = static_cast<int8_t>(hash & 0x7F);
+        uint64_t group = (hash >> 7) & groupMask;
+
+        // Triangular probing visits every group exactly once since the group count is a power of two.
+        for (uint64_t step = 1; step <= groupMask + 1; step++) {
+            const uint64_t base = group * HashTableControl::GroupWidth;
+            uint32_t matches = MatchControlGroup(&control[base], tag);
+
+            while (matches != 0) {
+                uint64_t slot = base + LowestBitIndex(matches);
+
+                if (array[slot].Hash == hash && CompareKeys(&array[slot], key.String, key.StringEnd)) {
+                    outSlot = slot;
+                    return true;
+                }
+                matches &= matches - 1;
+            }
+
+            // An empty slot means the key was never inserted past this point.
+            if (MatchControlGroup(&control[base], HashTableControl::Empty) != 0) {
                 return false;
             }
 
-            bIterator++;    // aIterator is handled by the for loop, so bIterator needs to be updated here.
+            group = (group + step) & groupMask;
         }
+        return false;
+    }
 
-        // All comparisons passed, the keys are the same.
-        return true;
+    static uint64_t FindFreeSlot(const int8_t* control, const uint64_t size, const uint64_t hash) {
+        /* Find the first empty or deleted slot along the probe sequence for hash. */
+
+        const uint64_t groupMask = (size / HashTableControl::GroupWidth) - 1;
+        uint64_t group = (hash >> 7) & groupMask;
+
+        for (uint64_t step = 1; step <= groupMask + 1; step++) {
+            const uint64_t base = group * HashTableControl::GroupWidth;
+            uint32_t free = MatchControlGroupFree(&control[base]);
+
+            if (free != 0) {
+                return base + LowestBitIndex(free);
+            }
+
+            group = (group + step) & groupMask;
+        }
+
+        // something went really wrong and an open slot could not be found.
+        assert(false);
+        return 0;
     }
-    
-    uint64_t SlotsUsed;
-    uint64_t Size;
-    HashTableItem* Array;
-};
+};
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+class JobSystem {
+    /* A fixed pool of worker threads for splitting a loop across every core.
+
+    ParallelFor cuts a range into batches and hands them out to the workers and the calling thread, which all pull
+    the next batch from a shared counter until the range is used up. It returns once every batch has run, so passes
+    that depend on each other (like one hierarchy level after another) can just be called one after the other.
+
+    Only one thread should call ParallelFor at a time. */
+
+public:
+
+    // threadCount includes the calling thread. 0 uses every hardware thread.
+    JobSystem(uint32_t threadCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    uint32_t ThreadCount() const { return static_cast<uint32_t>(Workers.size()) + 1; }
+
+    template<typename Function> void ParallelFor(uint32_t begin, uint32_t end, uint32_t batchSize, const Function& function) {
+        /* Call function(first, last) for every batch of batchSize indices in [begin, end). Batches run in any order,
+        on any thread. Ranges that fit in one batch run on the calling thread without waking anyone. */
+
+        if (begin >= end) {
+            return;
+        }
+
+        if (Workers.empty() || end - begin <= batchSize) {
+            function(begin, end);
+            return;
+        }
+
+        Run(begin, end, batchSize, &function, [](const void* context, uint32_t first, uint32_t last) {
+            (*static_cast<const Function*>(context))(first, last);
+        });
+    }
+
+private:
+
+    typedef void (*JobFunction)(const void* context, uint32_t first, uint32_t last);
+
+    std::vector<std::thread> Workers;
+    std::mutex Lock;
+    std::condition_variable WakeWorkers;
+    std::condition_variable WorkersDone;
+
+    // The current job. Only changed while holding Lock with no workers busy.
+    JobFunction Function;
+    const void* Context;
+    uint32_t Begin;
+    uint32_t End;
+    uint32_t BatchSize;
+    uint32_t BatchCount;
+    std::atomic<uint32_t> NextBatch;
+
+    uint64_t Generation;    // Goes up by one for every job, so workers can tell a new one has started.
+    uint32_t Busy;          // Workers currently running batches.
+    bool Quit;
+
+    void Run(uint32_t begin, uint32_t end, uint32_t batchSize, const void* context, JobFunction function);
+    void RunBatches();
+    void WorkerLoop();
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+class MappedFile {
+    /* A read only view of a whole file, mapped into memory instead of copied through a stream. The pages are read
+    from disk as they are touched, and the view stays valid until Close or the destructor.
+
+    Open prints why it failed and returns false, like the rest of the loaders. An empty file opens with a null Data
+    and a Size of 0. */
+
+public:
+
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const char* path);
+    void Close();
+
+    const char* Data() const { return View; }
+    size_t Size() const { return ViewSize; }
+
+private:
+
+    const char* View = nullptr;
+    size_t ViewSize = 0;
+
+#if defined(_WIN32)
+    void* FileHandle = nullptr;
+    void* MappingHandle = nullptr;
+#endif
+};
+
+
+// Size and last write time of a file, without opening it. The time is in the platform's own units (nanoseconds on
+// POSIX, 100 nanosecond intervals on Windows), so it is only meant for comparing against an earlier call on the same
+// platform. Prints nothing and returns false if there is no such file.
+bool GetFileInfo(const char* path, uint64_t& outSize, int64_t& outModifiedTime);
@@ -2,6 +2,7 @@
 
 //Forward Declarations
 template<typename T> class HashTable;
+struct StringId;
 struct Texture;
 
 typedef struct Material {
@@ -20,8 +21,13 @@ public:
     Material(const char* vertexProgramPath, const char* fragmentProgramPath, const uint16_t numberOfTextures, const GLenum cullFuncton, const GLenum depthFunction);
     ~Material();
 
+    // Materials live in a SlabPool, new and delete go through it.
+    static void* operator new(size_t size);
+    static void operator delete(void* material);
+
 } Material;
 
 void SetTextureFromPointer(const Material* material, Texture* texture, uint16_t index);
 void SetTextureFromAlias(const Material* material, const char* alias, uint16_t index);
+void SetTextureFromAlias(const Material* material, const StringId& alias, uint16_t index);
 void BindMaterial(const Material* material);
@@ -2,9 +2,13 @@
 #include <vector>
 #include "asset.h"
 
+// 16 bit indices reach vertices 0 to 65535. Meshes with more vertices are uploaded with 32 bit indices.
+#define MESH_MAX_SHORT_INDEX_VERTICES 0x10000
+
 //Forward Definitions:
 struct Material;
 struct Mesh;
+class JobSystem;
 
 struct StaticMesh {
     /* Data structure to store mesh data. */
@@ -26,7 +30,7 @@ struct StaticMesh {
 StaticMesh* CreateStaticMeshFromRawData(const uint16_t* indeciesArray, const  Vector3* vertexBufferArray, const  Vector3* normalBufferArray, const  Vector2* tCoordArray, const  size_t indecies, const  size_t vertecies);
 StaticMesh* CreateStaticMeshFromGraphicsLibraryTransmissionFormat(const char* Path);
 StaticMesh* CreateStaticMeshFromGraphicsLibraryBinaryTransmissionFormat(const char* Path);
-StaticMesh* CreateStaticMeshFromWavefront(const char* path);
+StaticMesh* CreateStaticMeshFromWavefront(const char* path, JobSystem* jobs = nullptr);
 
 // Par-Shapes wrapers:
 StaticMesh* CreateStaticMeshPrimativeCone(int slices, int stacks);
@@ -35,10 +39,4 @@ StaticMesh* CreateStaticMeshPrimativeTorus(int slices, int stacks, float radius)
 StaticMesh* CreateStaticMeshPrimativePlane(int slices, int stacks);
 StaticMesh* CreateStaticMeshPrimativeSphere(int subdivisions);
 
-// String parsing:
-static void parseFace(std::vector<uint16_t>* vi, std::vector<uint16_t>* ti, std::vector<uint16_t>* ni, std::vector<std::string> segmentList);
-static int parseFaceIndicies(std::vector<uint16_t>* vi, std::vector<uint16_t>* ti, std::vector<uint16_t>* ni, const std::string data);
-static Vector2 Vector2FromString(const std::string data);
-static Vector3 Vector3FromString(const std::string data);
-
 
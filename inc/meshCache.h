@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "mappedFile.h"
+#include "vectorMath.h"
+
+// "DMSH", written at the start of every .dmesh file.
+#define MESH_CACHE_MAGIC 0x48534D44
+
+// Bump whenever the layout changes, so old caches are rebuilt instead of misread.
+#define MESH_CACHE_VERSION 1
+
+// Caches sit next to their source with this extension in place of the source's.
+#define MESH_CACHE_EXTENSION ".dmesh"
+
+// Every section starts on this boundary, so vertices and indices can be handed to GL straight from the mapping.
+#define MESH_CACHE_ALIGNMENT 16
+
+
+struct MeshCacheSource {
+    /* The source file a cache was baked from. A cache is current if the source still has the same size and write
+    time. If only the write time changed, like after a checkout or a copy, the contents hash decides. */
+
+    uint64_t Size = 0;
+    int64_t ModifiedTime = 0;
+    uint64_t Hash = 0;
+};
+
+struct MeshCacheData {
+    /* A loaded .dmesh file. Vertices, Indices and SurfaceIndexCounts point into the mapped file, so they stay valid
+    until the next LoadMeshCache into this or until it is destroyed. */
+
+    MappedFile File;
+    std::string Name;
+
+    const Vertex* Vertices = nullptr;
+    size_t VertexCount = 0;
+
+    // IndexSize is 2 for uint16_t indices or 4 for uint32_t indices.
+    const void* Indices = nullptr;
+    uint32_t IndexSize = 0;
+    size_t IndexCount = 0;
+
+    // Indices per surface, in order. Always at least one.
+    const uint32_t* SurfaceIndexCounts = nullptr;
+    size_t SurfaceCount = 0;
+
+    // Bounds of every vertex position.
+    Vector3 BoundsMin = { 0.0f, 0.0f, 0.0f };
+    Vector3 BoundsMax = { 0.0f, 0.0f, 0.0f };
+};
+
+
+// Where the cache of a source file goes: the same path with MESH_CACHE_EXTENSION as its extension.
+std::string MeshCachePath(const char* sourcePath);
+
+// Hash of a source file's contents, to store in MeshCacheSource.
+uint64_t HashMeshSource(const char* data, size_t size);
+
+// Write a .dmesh file. Written to a temporary file and renamed into place, so a crash never leaves half a cache.
+bool WriteMeshCache(const char* path, const MeshCacheSource& source, const std::string& name, const Vertex* vertices, size_t vertexCount,
+    const void* indices, uint32_t indexSize, size_t indexCount, const uint32_t* surfaceIndexCounts, size_t surfaceCount);
+
+// Map a .dmesh file. Returns false, quietly, if there is no cache or it is out of date with sourcePath. If sourcePath
+// doesn't exist the cache is used as it is. Prints why and returns false if the cache is damaged.
+bool LoadMeshCache(const char* path, const char* sourcePath, MeshCacheData& outData);
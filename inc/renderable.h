@@ -2,13 +2,22 @@
 
 #include <glad/glad.h>
 
+#include <cstddef>
+#include <cstdint>
+
 struct Material;
 struct Matrix;
+struct Vertex;
 
 typedef struct Mesh {
     /* This is the core structure of a mesh, it does not have any ability to manage itself at all. */
 
-    GLsizei indexBytes = 0;
+    // Indices in ElementBufferObject, and their type: GL_UNSIGNED_SHORT, or GL_UNSIGNED_INT for more than 65536 vertices.
+    GLsizei indexCount = 0;
+    GLenum indexType = GL_UNSIGNED_SHORT;
+
+    // Set when every attribute is in VertexBufferObject, one Vertex after another. The normal and UV buffers are unused.
+    bool interleaved = false;
 
     // Define GPU buffer objects:
     GLuint VertexAttributeObject = GL_NONE;       // Vertices with attributes that might be in different locations in the VBO. bind this to point to this mesh.
@@ -22,5 +31,11 @@ typedef struct Mesh {
 void DrawRenderable(const Mesh* mesh, const Material* material, const Matrix* transform, const GLfloat time);
 void FreeMesh(Mesh* mesh);
 void FreeSubMesh(Mesh* mesh);
+
+// Each upload takes 16 or 32 bit indices, and the mesh draws with whichever it was given.
 void UploadMesh(Mesh* mesh, const  uint16_t* indeciesArray, const  Vector3* vertexBufferArray, const  Vector3* normalBufferArray, const Vector2* tCoordArray, const  size_t indecies, const size_t vertecies);
-void UploadSubMesh(Mesh* mesh, Mesh* source, const uint16_t* indeciesArray, const uint16_t indecies);
+void UploadMesh(Mesh* mesh, const  uint32_t* indeciesArray, const  Vector3* vertexBufferArray, const  Vector3* normalBufferArray, const Vector2* tCoordArray, const  size_t indecies, const size_t vertecies);
+void UploadInterleavedMesh(Mesh* mesh, const uint16_t* indeciesArray, const Vertex* vertexArray, const size_t indecies, const size_t vertecies);
+void UploadInterleavedMesh(Mesh* mesh, const uint32_t* indeciesArray, const Vertex* vertexArray, const size_t indecies, const size_t vertecies);
+void UploadSubMesh(Mesh* mesh, Mesh* source, const uint16_t* indeciesArray, const size_t indecies);
+void UploadSubMesh(Mesh* mesh, Mesh* source, const uint32_t* indeciesArray, const size_t indecies);
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "alignedAlloc.h"
+#include "assetPool.h"
+
+// Elements per slab. Each slab keeps one bit per element in a single 64 bit word.
+#define SLAB_POOL_SLAB_ELEMENTS 64
+
+
+template<typename T> class SlabPool {
+    /* Fixed address storage for one type, for objects that are found by pointer rather than by handle, like the
+    materials, fonts and textures kept in HashTables.
+
+    Memory comes in slabs of SLAB_POOL_SLAB_ELEMENTS elements. Each slab is a power of two in size and aligned to its
+    own size, so the slab an element belongs to is found by masking its address. The first cache line of a slab
+    holds its header and the elements start on the next one. Elements never move, so pointers stay valid until
+    the element is freed.
+
+    Free elements are kept in a list threaded through their own memory, so Allocate and Free are O(1). Each slab
+    also keeps a bitmask of the elements in use, so ForEach walks the live elements in address order.
+
+    Like AssetPool this only hands out memory. The types that use it route their operator new and delete here. */
+
+public:
+
+    explicit SlabPool(uint8_t type) {
+        static_assert(sizeof(SlabHeader) <= POOL_CACHE_LINE, "The slab header must fit in the first cache line.");
+        static_assert(Alignment <= POOL_CACHE_LINE, "SlabPool can't align elements past a cache line.");
+
+        FreeList = nullptr;
+
+        SlabBytes = POOL_CACHE_LINE;
+        while (SlabBytes < POOL_CACHE_LINE + static_cast<uint64_t>(Stride) * SLAB_POOL_SLAB_ELEMENTS) {
+            SlabBytes <<= 1;
+        }
+
+        Stats.Type = type;
+        Stats.ElementSize = Stride;
+        RegisterPoolStats(type, &Stats);
+    }
+
+    ~SlabPool() {
+        /* Slabs are freed even if elements are still alive in them, their destructors are never run. */
+
+        RegisterPoolStats(Stats.Type, nullptr);
+
+        for (SlabHeader* slab : Slabs) {
+            FreeAligned(slab);
+        }
+    }
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    void* Allocate() {
+        /* Memory for one element. The caller constructs the object in it. */
+
+        if (FreeList == nullptr && !AddSlab()) {
+            return nullptr;
+        }
+
+        FreeElement* element = FreeList;
+        FreeList = element->Next;
+
+        SlabHeader* slab = FindSlab(element);
+        slab->Used |= 1ull << SlotOf(slab, element);
+
+        Stats.CountAllocation();
+        return element;
+    }
+
+    void Free(void* memory) {
+        /* Return memory from Allocate. The caller has already destructed the object. */
+
+        if (memory == nullptr) {
+            return;
+        }
+
+        SlabHeader* slab = FindSlab(memory);
+        const uint64_t bit = 1ull << SlotOf(slab, memory);
+        assert((slab->Used & bit) != 0 && "SlabPool: Freed an element twice.");
+
+        slab->Used &= ~bit;
+
+        FreeElement* element = static_cast<FreeElement*>(memory);
+        element->Next = FreeList;
+        FreeList = element;
+
+        Stats.CountFree();
+    }
+
+    template<typename Function> void ForEach(Function function) {
+        /* Call function(T*) on every live element, slab by slab in address order. */
+
+        for (SlabHeader* slab : Slabs) {
+            uint64_t used = slab->Used;
+
+            while (used != 0) {
+                const uint32_t slot = CountTrailingZeros(used);
+                used &= used - 1;
+                function(reinterpret_cast<T*>(ElementsOf(slab) + static_cast<uint64_t>(slot) * Stride));
+            }
+        }
+    }
+
+    uint64_t Count() const { return Stats.Live; }
+    const PoolStats& GetStats() const { return Stats; }
+
+private:
+
+    struct SlabHeader {
+        uint64_t Used;
+    };
+
+    struct FreeElement {
+        FreeElement* Next;
+    };
+
+    // Every slot has to hold a free list link and stay aligned for both it and T.
+    static const uint32_t Alignment = (alignof(T) > alignof(FreeElement)) ? alignof(T) : alignof(FreeElement);
+    static const uint32_t Stride = (sizeof(T) + Alignment - 1) / Alignment * Alignment;
+
+    uint64_t SlabBytes;
+    std::vector<SlabHeader*> Slabs;
+    FreeElement* FreeList;
+    PoolStats Stats;
+
+    static uint8_t* ElementsOf(SlabHeader* slab) {
+        return reinterpret_cast<uint8_t*>(slab) + POOL_CACHE_LINE;
+    }
+
+    SlabHeader* FindSlab(const void* element) const {
+        return reinterpret_cast<SlabHeader*>(reinterpret_cast<uintptr_t>(element) & ~static_cast<uintptr_t>(SlabBytes - 1));
+    }
+
+    static uint32_t SlotOf(SlabHeader* slab, const void* element) {
+        return static_cast<uint32_t>((static_cast<const uint8_t*>(element) - ElementsOf(slab)) / Stride);
+    }
+
+    static uint32_t CountTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<uint32_t>(index);
+#else
+        return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+    }
+
+    bool AddSlab() {
+        SlabHeader* slab = static_cast<SlabHeader*>(AllocateAligned(SlabBytes, SlabBytes));
+
+        if (slab == nullptr) {
+            return false;
+        }
+
+        slab->Used = 0;
+        Slabs.push_back(slab);
+
+        // Push the slots in reverse so the lowest addresses are handed out first.
+        uint8_t* elements = ElementsOf(slab);
+        for (uint32_t i = SLAB_POOL_SLAB_ELEMENTS; i-- > 0;) {
+            FreeElement* element = reinterpret_cast<FreeElement*>(elements + static_cast<uint64_t>(i) * Stride);
+            element->Next = FreeList;
+            FreeList = element;
+        }
+
+        Stats.Capacity += SLAB_POOL_SLAB_ELEMENTS;
+        Stats.BytesReserved += SlabBytes;
+        return true;
+    }
+};
+
+
+template<typename T> SlabPool<T>& GetSlabPool(uint8_t type) {
+    /* The pool for one type, created the first time it's needed. It is never destroyed, since objects in it can
+    still be deleted by static HashTables while the program exits. */
+    static SlabPool<T>* pool = new SlabPool<T>(type);
+    return *pool;
+}
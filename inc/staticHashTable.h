@@ -0,0 +1,379 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "hashTable.h"
+
+// Average number of keys that share a displacement. Larger buckets make the table smaller but slower to build.
+#define STATIC_HASH_TABLE_BUCKET_SIZE 4
+
+// "SHT1", written at the start of serialized tables.
+#define STATIC_HASH_TABLE_MAGIC 0x31544853
+
+// Bump whenever the serialized layout or the key hash changes, so old tables are rejected instead of misread.
+#define STATIC_HASH_TABLE_VERSION 1
+
+
+inline uint32_t StaticHashReduce(const uint32_t hash, const uint32_t range) {
+    /* Map a 32 bit hash onto [0, range) with a multiply instead of a divide. */
+    return static_cast<uint32_t>((static_cast<uint64_t>(hash) * range) >> 32);
+}
+
+inline uint32_t StaticHashSlot(const uint64_t hash, const uint32_t displacement, const uint32_t size) {
+    /* Rehash a key's hash with its bucket's displacement and pick a slot. */
+
+    uint64_t mixed = hash ^ (static_cast<uint64_t>(displacement) * 0x9E3779B97F4A7C15);
+    mixed ^= mixed >> 33;
+    mixed *= 0xFF51AFD7ED558CCD;
+    mixed ^= mixed >> 33;
+    return StaticHashReduce(static_cast<uint32_t>(mixed >> 32), size);
+}
+
+
+template<typename T> class StaticHashTable {
+    /* Immutable hash table for key sets that are known up front, like the aliases baked into an asset pack.
+
+    Build generates a minimal perfect hash with the hash and displace (CHD) method. Keys are split into buckets by
+    their hash, and every bucket stores one displacement that moves all of its keys into free slots. A lookup reads
+    the displacement, computes the slot, and compares that one item, so every Find is exactly one probe and the
+    table has no empty slots.
+
+    The slot a key lands in is also its index, from 0 to Size - 1. The index does not change when the table is
+    serialized, so values can be stored in the same order next to it.
+
+    The table does not own its values. */
+
+    struct StaticHashTableItem {
+        uint64_t Hash;
+        uint32_t KeyOffset;     // Where the key starts in Keys. Keys are null terminated.
+        uint32_t KeyLength;
+        T* Value;
+    };
+
+public:
+
+    StaticHashTable() {
+        Size = 0;
+        BucketCount = 0;
+        KeysSize = 0;
+        Displacements = nullptr;
+        Array = nullptr;
+        Keys = nullptr;
+    }
+
+    ~StaticHashTable() {
+        Clear();
+    }
+
+    StaticHashTable(const StaticHashTable&) = delete;
+    StaticHashTable& operator=(const StaticHashTable&) = delete;
+
+    bool Build(const StringId* keys, T* const* values, const uint64_t count) {
+        /* Build the table from count keys and their values. values may be null, in which case every value starts
+        as null and can be set with SetValue. Keys are copied. Returns false, leaving the table empty, if a key is
+        repeated or two keys have the same 64 bit hash. */
+
+        Clear();
+
+        if (count == 0) {
+            return true;
+        }
+
+        if (count > 0xFFFFFFFF) {
+            std::cout << "StaticHashTable: Too many keys (" << count << ")." << std::endl;
+            return false;
+        }
+
+        // Two keys with the same hash would always land in the same slot, so check for that first.
+        std::vector<uint32_t> byHash(count);
+        for (uint32_t i = 0; i < count; i++) {
+            byHash[i] = i;
+        }
+        std::sort(byHash.begin(), byHash.end(), [keys](uint32_t a, uint32_t b) { return keys[a].Hash < keys[b].Hash; });
+
+        uint64_t keysSize = 0;
+        for (uint64_t i = 0; i < count; i++) {
+            keysSize += (keys[i].StringEnd - keys[i].String) + 1;
+
+            if (i > 0 && keys[byHash[i]].Hash == keys[byHash[i - 1]].Hash) {
+                const StringId& key = keys[byHash[i]];
+                const StringId& other = keys[byHash[i - 1]];
+                const bool same = (key.StringEnd - key.String) == (other.StringEnd - other.String) && memcmp(key.String, other.String, key.StringEnd - key.String) == 0;
+
+                std::cout << "StaticHashTable: " << (same ? "Duplicate key " : "Hash collision on key ") << std::string(key.String, key.StringEnd) << "." << std::endl;
+                return false;
+            }
+        }
+
+        if (keysSize > 0xFFFFFFFF) {
+            std::cout << "StaticHashTable: Keys are too large (" << keysSize << " bytes)." << std::endl;
+            return false;
+        }
+
+        const uint32_t size = static_cast<uint32_t>(count);
+        const uint32_t bucketCount = (size + STATIC_HASH_TABLE_BUCKET_SIZE - 1) / STATIC_HASH_TABLE_BUCKET_SIZE;
+
+        // Group the keys by bucket, then place the biggest buckets first while the table is still mostly empty.
+        std::vector<uint32_t> bucketStart(bucketCount + 1, 0);
+        for (uint32_t i = 0; i < size; i++) {
+            bucketStart[GetBucket(keys[i].Hash, bucketCount) + 1]++;
+        }
+        for (uint32_t b = 0; b < bucketCount; b++) {
+            bucketStart[b + 1] += bucketStart[b];
+        }
+
+        std::vector<uint32_t> bucketKeys(size);
+        std::vector<uint32_t> bucketFill(bucketStart.begin(), bucketStart.end() - 1);
+        for (uint32_t i = 0; i < size; i++) {
+            bucketKeys[bucketFill[GetBucket(keys[i].Hash, bucketCount)]++] = i;
+        }
+
+        std::vector<uint32_t> bucketOrder(bucketCount);
+        for (uint32_t b = 0; b < bucketCount; b++) {
+            bucketOrder[b] = b;
+        }
+        std::stable_sort(bucketOrder.begin(), bucketOrder.end(), [&bucketStart](uint32_t a, uint32_t b) {
+            return bucketStart[a + 1] - bucketStart[a] > bucketStart[b + 1] - bucketStart[b];
+        });
+
+        uint32_t* displacements = new uint32_t[bucketCount]();
+        std::vector<int32_t> slotKey(size, -1);
+        std::vector<uint32_t> slots;
+
+        for (const uint32_t bucket : bucketOrder) {
+
+            const uint32_t first = bucketStart[bucket];
+            const uint32_t last = bucketStart[bucket + 1];
+
+            if (first == last) {
+                continue;
+            }
+
+            // Try displacements until every key in the bucket lands on a slot nobody else has taken.
+            bool placed = false;
+            for (uint64_t displacement = 0; displacement <= 0xFFFFFFFF && !placed; displacement++) {
+
+                slots.clear();
+                placed = true;
+
+                for (uint32_t k = first; k < last; k++) {
+                    const uint32_t slot = StaticHashSlot(keys[bucketKeys[k]].Hash, static_cast<uint32_t>(displacement), size);
+
+                    if (slotKey[slot] != -1 || std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+                        placed = false;
+                        break;
+                    }
+                    slots.push_back(slot);
+                }
+
+                if (placed) {
+                    displacements[bucket] = static_cast<uint32_t>(displacement);
+                    for (uint32_t k = first; k < last; k++) {
+                        slotKey[slots[k - first]] = static_cast<int32_t>(bucketKeys[k]);
+                    }
+                }
+            }
+
+            if (!placed) {
+                std::cout << "StaticHashTable: Could not find a displacement for bucket " << bucket << "." << std::endl;
+                delete[] displacements;
+                return false;
+            }
+        }
+
+        Size = size;
+        BucketCount = bucketCount;
+        Displacements = displacements;
+        Array = new StaticHashTableItem[Size];
+        Keys = new char[keysSize];
+        KeysSize = keysSize;
+
+        // Copy the keys in slot order, so walking the table walks the key block front to back.
+        uint32_t keyOffset = 0;
+        for (uint32_t slot = 0; slot < Size; slot++) {
+            const StringId& key = keys[slotKey[slot]];
+            const uint32_t keyLength = static_cast<uint32_t>(key.StringEnd - key.String);
+
+            memcpy(Keys + keyOffset, key.String, keyLength);
+            Keys[keyOffset + keyLength] = '\0';
+
+            Array[slot].Hash = key.Hash;
+            Array[slot].KeyOffset = keyOffset;
+            Array[slot].KeyLength = keyLength;
+            Array[slot].Value = (values != nullptr) ? values[slotKey[slot]] : nullptr;
+
+            keyOffset += keyLength + 1;
+        }
+
+        return true;
+    }
+
+    bool Find(const char* key, T*& outValue) const {
+        return Find(StringId(key), outValue);
+    }
+
+    bool Find(const char* key, const uint64_t keyLength, T*& outValue) const {
+        return Find(StringId(key, keyLength), outValue);
+    }
+
+    bool Find(const StringId& key, T*& outValue) const {
+
+        const int64_t index = IndexOf(key);
+
+        if (index < 0) {
+            return false;
+        }
+
+        outValue = Array[index].Value;
+        return true;
+    }
+
+    int64_t IndexOf(const StringId& key) const {
+        /* Returns the key's slot, or -1 if the key is not in the table. */
+
+        if (Size == 0) {
+            return -1;
+        }
+
+        const uint32_t displacement = Displacements[GetBucket(key.Hash, BucketCount)];
+        const uint32_t slot = StaticHashSlot(key.Hash, displacement, Size);
+        const StaticHashTableItem& item = Array[slot];
+        const uint64_t keyLength = key.StringEnd - key.String;
+
+        // Keys that are not in the table still map to some slot, so the key has to be checked.
+        if (item.Hash != key.Hash || item.KeyLength != keyLength || memcmp(Keys + item.KeyOffset, key.String, keyLength) != 0) {
+            return -1;
+        }
+
+        return slot;
+    }
+
+    const char* GetKey(const uint64_t index) const {
+        return Keys + Array[index].KeyOffset;
+    }
+
+    T* GetValue(const uint64_t index) const {
+        return Array[index].Value;
+    }
+
+    void SetValue(const uint64_t index, T* value) {
+        Array[index].Value = value;
+    }
+
+    void Serialize(std::vector<uint8_t>& out) const {
+        /* Append the table, without its values, to out. The layout is the header (magic, version, size, bucket
+        count and key block size as uint32), the displacements, each item's hash, key offset and key length, then
+        the key block. Integers are written in the machine's byte order. */
+
+        const uint32_t header[5] = { STATIC_HASH_TABLE_MAGIC, STATIC_HASH_TABLE_VERSION, Size, BucketCount, KeysSize };
+        Append(out, header, sizeof(header));
+        Append(out, Displacements, BucketCount * sizeof(uint32_t));
+
+        for (uint32_t slot = 0; slot < Size; slot++) {
+            Append(out, &Array[slot].Hash, sizeof(uint64_t));
+            Append(out, &Array[slot].KeyOffset, sizeof(uint32_t));
+            Append(out, &Array[slot].KeyLength, sizeof(uint32_t));
+        }
+
+        Append(out, Keys, KeysSize);
+    }
+
+    uint64_t Deserialize(const uint8_t* data, const uint64_t dataSize) {
+        /* Load a table written by Serialize. Every value starts as null, set them with SetValue in the same order
+        they were stored. Returns the number of bytes read, or 0 if the data is not a valid table. */
+
+        Clear();
+
+        uint32_t header[5];
+        if (dataSize < sizeof(header)) {
+            std::cout << "StaticHashTable: Data is too small to hold a table." << std::endl;
+            return 0;
+        }
+        memcpy(header, data, sizeof(header));
+
+        if (header[0] != STATIC_HASH_TABLE_MAGIC || header[1] != STATIC_HASH_TABLE_VERSION) {
+            std::cout << "StaticHashTable: Data is not a table, or was written by a different version." << std::endl;
+            return 0;
+        }
+
+        const uint32_t size = header[2];
+        const uint32_t bucketCount = header[3];
+        const uint32_t keysSize = header[4];
+        const uint64_t itemBytes = sizeof(uint64_t) + 2 * sizeof(uint32_t);
+        const uint64_t totalSize = sizeof(header) + static_cast<uint64_t>(bucketCount) * sizeof(uint32_t) + size * itemBytes + keysSize;
+
+        if (totalSize > dataSize || (size == 0) != (bucketCount == 0)) {
+            std::cout << "StaticHashTable: Data is not a valid table." << std::endl;
+            return 0;
+        }
+
+        const uint8_t* read = data + sizeof(header);
+        const uint8_t* keys = read + bucketCount * sizeof(uint32_t) + size * itemBytes;
+
+        StaticHashTableItem* array = new StaticHashTableItem[size];
+        for (uint32_t slot = 0; slot < size; slot++) {
+            const uint8_t* item = read + bucketCount * sizeof(uint32_t) + slot * itemBytes;
+            memcpy(&array[slot].Hash, item, sizeof(uint64_t));
+            memcpy(&array[slot].KeyOffset, item + sizeof(uint64_t), sizeof(uint32_t));
+            memcpy(&array[slot].KeyLength, item + sizeof(uint64_t) + sizeof(uint32_t), sizeof(uint32_t));
+            array[slot].Value = nullptr;
+
+            // Every key has to fit in the key block and end in its null terminator, or GetKey would run off the end.
+            const uint64_t keyEnd = static_cast<uint64_t>(array[slot].KeyOffset) + array[slot].KeyLength;
+            if (keyEnd >= keysSize || keys[keyEnd] != '\0') {
+                std::cout << "StaticHashTable: Data is not a valid table." << std::endl;
+                delete[] array;
+                return 0;
+            }
+        }
+
+        Size = size;
+        BucketCount = bucketCount;
+        KeysSize = keysSize;
+        Array = array;
+
+        Displacements = new uint32_t[BucketCount];
+        memcpy(Displacements, read, BucketCount * sizeof(uint32_t));
+
+        Keys = new char[KeysSize];
+        memcpy(Keys, keys, KeysSize);
+
+        return totalSize;
+    }
+
+    void Clear() {
+        delete[] Displacements;
+        delete[] Array;
+        delete[] Keys;
+        Displacements = nullptr;
+        Array = nullptr;
+        Keys = nullptr;
+        Size = 0;
+        BucketCount = 0;
+        KeysSize = 0;
+    }
+
+    uint32_t Size;              // Number of keys, which is also the number of slots.
+    uint32_t BucketCount;
+    uint32_t KeysSize;          // Bytes in Keys.
+
+private:
+
+    uint32_t* Displacements;
+    StaticHashTableItem* Array;
+    char* Keys;
+
+    static uint32_t GetBucket(const uint64_t hash, const uint32_t bucketCount) {
+        // StaticHashSlot mixes the whole hash, so the bucket can come straight from the top bits.
+        return StaticHashReduce(static_cast<uint32_t>(hash >> 32), bucketCount);
+    }
+
+    static void Append(std::vector<uint8_t>& out, const void* data, const uint64_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        out.insert(out.end(), bytes, bytes + size);
+    }
+};
@@ -3,6 +3,7 @@
 #include <cassert>
 
 template <typename T> class HashTable;
+struct StringId;
 
 typedef struct Texture {
     // Struct to hold graphics data for a texture. Avoid using this manually since the system cannot track it.
@@ -22,6 +23,10 @@ typedef struct Texture {
     Texture() : alias(nullptr), ID(GL_NONE), filterType(GL_LINEAR), width(0), height(0), channels(0), references(0) { }
     ~Texture() { }
 
+    // Textures live in a SlabPool, new and delete go through it.
+    static void* operator new(size_t size);
+    static void operator delete(void* texture);
+
 } Texture;
 
 
@@ -29,10 +34,11 @@ namespace TextureManager {
     void InternalUploadTexture(Texture* texture, uint8_t* data, GLenum internalFormat, GLenum format);
     void InternalUploadTextureMimmap(Texture* texture, uint8_t* data, GLenum internalFormat, GLenum format);
     void InternalDeleteTexture(Texture* texture);
-    void InternalCreateTexture(Texture* texture, const bool isManaged, const char* alias, const GLenum internalFormat, const GLenum format, uint8_t* data, const bool useMipmaps);
+    void InternalCreateTexture(Texture* texture, const bool isManaged, const StringId& alias, const GLenum internalFormat, const GLenum format, uint8_t* data, const bool useMipmaps);
     void CreateRawTexture(const char* path, Texture* texture, GLenum internalFormat = GL_RGBA, GLenum format = GL_RGBA, bool flipVertical = false, bool flipHorizontal = false, bool useMipmaps = true, int filterType = GL_LINEAR);
     
     bool FindTexture(const char* alias, Texture*& outValue);
+    bool FindTexture(const StringId& alias, Texture*& outValue);
 
 }
 
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "vectorMath.h"
+
+class JobSystem;
+
+typedef uint32_t TransformHandle;
+
+// Returned when there is no transform, and used as the parent of root transforms.
+#define INVALID_TRANSFORM 0xFFFFFFFF
+
+// Transforms per job when updating on several threads. Big enough that one batch is worth waking a thread for.
+#define TRANSFORM_BATCH_SIZE 1024
+
+
+namespace TransformFlags {
+    const uint8_t None          = 0x00;
+    const uint8_t Dirty         = 0x01;     // The world matrix needs to be recomputed, along with every child's.
+}
+
+
+class TransformStore {
+    /* Structure of arrays storage for every transform in a scene.
+
+    Position, rotation, scale and the world matrix each live in their own contiguous array, so a pass over all
+    transforms only pulls in the data it uses, in order. Transforms are referred to by a handle that stays the same
+    for their whole life. The arrays themselves are kept dense: deleting a transform moves the last one into its
+    place, and the handle table is updated to match.
+
+    The local transform is only ever stored as position, rotation and scale, 40 bytes instead of a 64 byte matrix.
+    It is expanded into a matrix when the world matrix is computed. Moving a transform edits its position directly,
+    so repeated small moves don't build up error the way multiplying a matrix by a translation every frame does.
+
+    The arrays are kept sorted so every parent comes before its children. That way UpdateTransforms can compute every
+    world matrix in one pass from front to back. Changing a transform marks it dirty, and the pass only recomputes
+    dirty transforms and their children, starting from the first dirty one. World matrices are cached between passes,
+    and are only valid after UpdateTransforms.
+
+    The threaded UpdateTransforms needs the arrays fully sorted by depth, so every level of the hierarchy is one
+    contiguous range. Each level is split into batches across the job system, and a level only starts once the one
+    above it is finished. Adding, removing or reparenting a transform means the next threaded update re-sorts first. */
+
+public:
+
+    TransformStore(uint32_t capacity = 1024);
+
+    TransformHandle Create();
+    void Delete(TransformHandle handle);
+    bool IsValid(TransformHandle handle) const;
+
+    // The pointer is only valid until the next Create, Delete or UpdateTransforms.
+    const Matrix* GetWorldMatrix(TransformHandle handle) const;
+
+    TRS GetLocal(TransformHandle handle) const;
+    void SetLocal(TransformHandle handle, TRS local);
+
+    // The local transform as a matrix. SetLocalMatrix splits the matrix up, and loses any shear in it.
+    Matrix GetLocalMatrix(TransformHandle handle) const;
+    void SetLocalMatrix(TransformHandle handle, Matrix local);
+
+    Vector3 GetPosition(TransformHandle handle) const;
+    Quaternion GetRotation(TransformHandle handle) const;
+    Vector3 GetScale(TransformHandle handle) const;
+    void SetPosition(TransformHandle handle, Vector3 position);
+    void SetRotation(TransformHandle handle, Quaternion rotation);
+    void SetScale(TransformHandle handle, Vector3 scale);
+
+    TransformHandle GetParent(TransformHandle handle) const;
+    void SetParent(TransformHandle handle, TransformHandle parent);
+
+    // Recompute the world matrix of every dirty transform and its children.
+    void UpdateTransforms();
+    void UpdateTransforms(JobSystem& jobs);
+
+    // Walk the parent chain for one transform. Does not need UpdateTransforms to have run.
+    Matrix ComputeWorldMatrix(TransformHandle handle) const;
+
+    // The cached world matrix if nothing above the transform has changed since the last update, otherwise computes it.
+    Matrix GetGlobalMatrix(TransformHandle handle) const;
+
+    uint32_t Count() const { return static_cast<uint32_t>(Handles.size()); }
+
+    // Dense arrays, all Count() long. Index i in each one belongs to the same transform, Handles[i].
+    std::vector<Vector3> Positions;
+    std::vector<Quaternion> Rotations;
+    std::vector<Vector3> Scales;
+    std::vector<Matrix> WorldMatrices;
+    std::vector<TransformHandle> Parents;
+    std::vector<uint8_t> Flags;
+    std::vector<TransformHandle> Handles;
+
+private:
+
+    // Maps a handle to its dense index. Unused entries hold the next unused handle instead, forming a free list.
+    std::vector<uint32_t> Sparse;
+    uint32_t FreeHead;
+
+    uint32_t FirstDirty;    // Lowest index with the Dirty flag, or Count() if none are.
+    bool NeedsSort;         // Some transform's parent is after it in the arrays.
+    bool LevelsValid;       // The arrays are sorted by depth and LevelStart matches them.
+
+    // Index of the first transform at each depth, plus Count() at the end.
+    std::vector<uint32_t> LevelStart;
+
+    uint32_t GetIndex(TransformHandle handle) const;
+    Matrix LocalMatrix(uint32_t index) const;
+    void MarkDirty(uint32_t index);
+    void SortHierarchy();
+    void UpdateRange(uint32_t first, uint32_t last);
+};
+
+
+// The store used by every asset.
+TransformStore& GetTransformStore();
+
+
+struct AssetTransform {
+    /* The transform member of ASSET_BODY. Holds a handle into the global store, and frees it with the asset. */
+
+    TransformHandle Handle;
+
+    AssetTransform() : Handle(GetTransformStore().Create()) { }
+    ~AssetTransform() { GetTransformStore().Delete(Handle); }
+
+    // Two assets can't share a transform.
+    AssetTransform(const AssetTransform&) = delete;
+    AssetTransform& operator=(const AssetTransform&) = delete;
+};
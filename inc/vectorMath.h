@@ -1,6 +1,9 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cmath>
+#include <cstring>
 
 using namespace std;
 
@@ -9,6 +12,9 @@ using namespace std;
 //----------------------------------------------------------------------------------
 #define RMAPI inline
 
+// Pure arithmetic, usable in constant expressions. Matrices built from constant arguments fold at compile time.
+#define RMCONSTEXPR constexpr
+
 #ifndef PI
 #define PI 3.14159265358979323846f
 #endif
@@ -25,6 +31,22 @@ using namespace std;
 #define RAD2DEG (180.0f/PI)
 #endif
 
+// SSE2 is part of every x86-64 target, so the Matrix and Quaternion kernels use it unless VECTOR_MATH_NO_SIMD is
+// defined. Building for a CPU with FMA (-mfma, -march=haswell or /arch:AVX2) fuses their multiply-adds as well.
+#if !defined(VECTOR_MATH_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define VECTOR_MATH_USE_SSE
+#include <emmintrin.h>
+#if defined(__FMA__) || defined(__AVX2__)
+#define VECTOR_MATH_USE_FMA
+#endif
+#if defined(__AVX__)
+#define VECTOR_MATH_USE_AVX
+#endif
+#if defined(VECTOR_MATH_USE_FMA) || defined(VECTOR_MATH_USE_AVX)
+#include <immintrin.h>
+#endif
+#endif
+
 typedef struct float3 {
     float v[3]{};
 } float3;
@@ -37,6 +59,12 @@ typedef struct float16 {
     float v[16]{};
 } float16;
 
+// A Matrix as the GPU reads a mat4: column-major, starting m0 m1 m2 m3, and 16 byte aligned like a std140 or std430
+// mat4. Arrays of these can be copied straight into uniform, storage or instance buffers.
+typedef struct alignas(16) GpuMatrix {
+    float v[16]{};
+} GpuMatrix;
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
@@ -62,15 +90,15 @@ struct Vector2 {
     RMAPI operator Vector3() const;
 };
 
-RMAPI Vector2 operator+(Vector2 a, Vector2 b);
-RMAPI Vector2 operator-(Vector2 a, Vector2 b);
-RMAPI Vector2 operator*(Vector2 a, Vector2 b);
-RMAPI Vector2 operator/(Vector2 a, Vector2 b);
+RMCONSTEXPR Vector2 operator+(Vector2 a, Vector2 b);
+RMCONSTEXPR Vector2 operator-(Vector2 a, Vector2 b);
+RMCONSTEXPR Vector2 operator*(Vector2 a, Vector2 b);
+RMCONSTEXPR Vector2 operator/(Vector2 a, Vector2 b);
 
-RMAPI Vector2 operator+(Vector2 a, float b);
-RMAPI Vector2 operator-(Vector2 a, float b);
-RMAPI Vector2 operator*(Vector2 a, float b);
-RMAPI Vector2 operator/(Vector2 a, float b);
+RMCONSTEXPR Vector2 operator+(Vector2 a, float b);
+RMCONSTEXPR Vector2 operator-(Vector2 a, float b);
+RMCONSTEXPR Vector2 operator*(Vector2 a, float b);
+RMCONSTEXPR Vector2 operator/(Vector2 a, float b);
 
 struct Vector3 {
     float x;
@@ -91,15 +119,15 @@ struct Vector3 {
     RMAPI operator Vector4() const;
 };
 
-RMAPI Vector3 operator+(Vector3 a, Vector3 b);
-RMAPI Vector3 operator-(Vector3 a, Vector3 b);
-RMAPI Vector3 operator*(Vector3 a, Vector3 b);
-RMAPI Vector3 operator/(Vector3 a, Vector3 b);
+RMCONSTEXPR Vector3 operator+(Vector3 a, Vector3 b);
+RMCONSTEXPR Vector3 operator-(Vector3 a, Vector3 b);
+RMCONSTEXPR Vector3 operator*(Vector3 a, Vector3 b);
+RMCONSTEXPR Vector3 operator/(Vector3 a, Vector3 b);
 
-RMAPI Vector3 operator+(Vector3 a, float b);
-RMAPI Vector3 operator-(Vector3 a, float b);
-RMAPI Vector3 operator*(Vector3 a, float b);
-RMAPI Vector3 operator/(Vector3 a, float b);
+RMCONSTEXPR Vector3 operator+(Vector3 a, float b);
+RMCONSTEXPR Vector3 operator-(Vector3 a, float b);
+RMCONSTEXPR Vector3 operator*(Vector3 a, float b);
+RMCONSTEXPR Vector3 operator/(Vector3 a, float b);
 
 struct Vector4 {
     float x;
@@ -120,15 +148,15 @@ struct Vector4 {
     RMAPI operator Vector3() const;
 };
 
-RMAPI Vector4 operator+(Vector4 a, Vector4 b);
-RMAPI Vector4 operator-(Vector4 a, Vector4 b);
+RMCONSTEXPR Vector4 operator+(Vector4 a, Vector4 b);
+RMCONSTEXPR Vector4 operator-(Vector4 a, Vector4 b);
 RMAPI Vector4 operator*(Vector4 a, Vector4 b);
-RMAPI Vector4 operator/(Vector4 a, Vector4 b);
+RMCONSTEXPR Vector4 operator/(Vector4 a, Vector4 b);
 
-RMAPI Vector4 operator+(Vector4 a, float b);
-RMAPI Vector4 operator-(Vector4 a, float b);
-RMAPI Vector4 operator*(Vector4 a, float b);
-RMAPI Vector4 operator/(Vector4 a, float b);
+RMCONSTEXPR Vector4 operator+(Vector4 a, float b);
+RMCONSTEXPR Vector4 operator-(Vector4 a, float b);
+RMCONSTEXPR Vector4 operator*(Vector4 a, float b);
+RMCONSTEXPR Vector4 operator/(Vector4 a, float b);
 
 typedef Vector4 Quaternion;
 
@@ -142,15 +170,43 @@ typedef struct Matrix {
     float m3, m7, m11, m15;     // Matrix fourth row (4 components)
 } Matrix;
 
-RMAPI Matrix operator+(Matrix a, Matrix b);
-RMAPI Matrix operator-(Matrix a, Matrix b);
+RMCONSTEXPR Matrix operator+(Matrix a, Matrix b);
+RMCONSTEXPR Matrix operator-(Matrix a, Matrix b);
 RMAPI Matrix operator*(Matrix a, Matrix b);
 // No need for matrix division.
 
+// Translation, rotation and scale, 40 bytes against a Matrix's 64. Applied to a point as scale, then rotation, then
+// translation, the same as Scale(scale) * ToMatrix(rotation) * Translate(translation).
+typedef struct TRS {
+    Vector3 translation;
+    Quaternion rotation;
+    Vector3 scale;
+} TRS;
+
+RMAPI TRS operator*(TRS a, TRS b);
+
+// A plane as the points p where Dot(normal, p) + distance == 0. Points with a positive value are in front of it.
+typedef struct Plane {
+    Vector3 normal;
+    float distance;
+} Plane;
+
+// The six planes bounding a view-projection's clip space, all facing inwards: left, right, bottom, top, near, far.
+typedef struct FrustumPlanes {
+    Plane planes[6];
+} FrustumPlanes;
+
+// One vertex of an interleaved vertex buffer, 32 bytes, in the attribute order the shaders use.
+typedef struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+    Vector2 textureCoord;
+} Vertex;
+
 RMAPI Vector4 operator*(Matrix m, Vector4 v);
-RMAPI Vector3 operator*(Matrix m, Vector3 v);
-RMAPI Vector2 operator*(Matrix m, Vector2 v);
-RMAPI Vector3 operator*(Quaternion a, Vector3 b);
+RMCONSTEXPR Vector3 operator*(Matrix m, Vector3 v);
+RMCONSTEXPR Vector2 operator*(Matrix m, Vector2 v);
+RMCONSTEXPR Vector3 operator*(Quaternion a, Vector3 b);
 
 constexpr Vector2 V2_RIGHT = { 1.0f, 0.0f };
 constexpr Vector2 V2_UP = { 0.0f, 1.0f };
@@ -181,7 +237,7 @@ constexpr Vector4 V4_IDENTITY = { 0.0f, 0.0f, 0.0f, 1.0f };
 // (I don't like the above macros because you can just do ToFloatN.v for float*)
 
 // Get Vector3 as float array
-RMAPI float3 ToFloat3(Vector3 v)
+RMCONSTEXPR float3 ToFloat3(Vector3 v)
 {
     float3 buffer = { 0 };
 
@@ -192,7 +248,7 @@ RMAPI float3 ToFloat3(Vector3 v)
     return buffer;
 }
 
-RMAPI float9 ToFloat9(Matrix mat)
+RMCONSTEXPR float9 ToFloat9(Matrix mat)
 {
     float9 result = { 0 };
 
@@ -213,7 +269,7 @@ RMAPI float9 ToFloat9(Matrix mat)
 
 // Get float array of matrix data (transposes the matrix from row-major to column-major)!
 // col0 = v[0-3], col1 = v[4-7], col2 = v[8-11], col3 = v[12-15]. Inspect in debugger!!!!
-RMAPI float16 ToFloat16(Matrix mat)
+RMCONSTEXPR float16 ToFloat16(Matrix mat)
 {
     float16 result = { 0 };
 
@@ -237,10 +293,159 @@ RMAPI float16 ToFloat16(Matrix mat)
     return result;
 }
 
+// Get the matrix in GPU layout, the same values as ToFloat16
+// NOTE: A single matrix doesn't need this, glUniformMatrix4fv can read a Matrix directly with transpose set to GL_TRUE
+RMCONSTEXPR GpuMatrix ToGpuMatrix(Matrix mat)
+{
+    GpuMatrix result = { 0 };
+
+    result.v[0] = mat.m0;
+    result.v[1] = mat.m1;
+    result.v[2] = mat.m2;
+    result.v[3] = mat.m3;
+    result.v[4] = mat.m4;
+    result.v[5] = mat.m5;
+    result.v[6] = mat.m6;
+    result.v[7] = mat.m7;
+    result.v[8] = mat.m8;
+    result.v[9] = mat.m9;
+    result.v[10] = mat.m10;
+    result.v[11] = mat.m11;
+    result.v[12] = mat.m12;
+    result.v[13] = mat.m13;
+    result.v[14] = mat.m14;
+    result.v[15] = mat.m15;
+
+    return result;
+}
+
+#ifdef VECTOR_MATH_USE_SSE
+//----------------------------------------------------------------------------------
+// Module Functions Definition - SIMD helpers
+//----------------------------------------------------------------------------------
+
+// Pick lanes x, y from a and z, w from b
+#define SIMD_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+#define SIMD_SWIZZLE(v, x, y, z, w) SIMD_SHUFFLE(v, v, x, y, z, w)
+
+// a * b + c, fused when the CPU has FMA
+RMAPI __m128 SimdMultiplyAdd(__m128 a, __m128 b, __m128 c)
+{
+#ifdef VECTOR_MATH_USE_FMA
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+#ifdef VECTOR_MATH_USE_AVX
+RMAPI __m256 SimdMultiplyAdd(__m256 a, __m256 b, __m256 c)
+{
+#ifdef VECTOR_MATH_USE_FMA
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+#endif
+
+// Sum of all four lanes, in every lane
+RMAPI __m128 SimdHorizontalSum(__m128 v)
+{
+    __m128 pairs = _mm_add_ps(v, SIMD_SWIZZLE(v, 1, 0, 3, 2));
+    return _mm_add_ps(pairs, SIMD_SWIZZLE(pairs, 2, 3, 0, 1));
+}
+
+// Number of bits set in a movemask result of up to 8 lanes
+RMAPI size_t SimdMaskCount(uint64_t mask)
+{
+    static const unsigned char bits[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+    return bits[mask & 15] + bits[(mask >> 4) & 15];
+}
+
+// Load the four rows of a matrix as it is laid out in memory (m0 m4 m8 m12, m1 m5 m9 m13, ...)
+RMAPI void SimdLoadRows(const Matrix& mat, __m128 rows[4])
+{
+    const float* data = reinterpret_cast<const float*>(&mat);
+    rows[0] = _mm_loadu_ps(data);
+    rows[1] = _mm_loadu_ps(data + 4);
+    rows[2] = _mm_loadu_ps(data + 8);
+    rows[3] = _mm_loadu_ps(data + 12);
+}
+
+RMAPI void SimdStoreRows(Matrix& mat, const __m128 rows[4])
+{
+    float* data = reinterpret_cast<float*>(&mat);
+    _mm_storeu_ps(data, rows[0]);
+    _mm_storeu_ps(data + 4, rows[1]);
+    _mm_storeu_ps(data + 8, rows[2]);
+    _mm_storeu_ps(data + 12, rows[3]);
+}
+
+// 2x2 matrices packed as (a b c d) for the block inverse: a * b, adjugate(a) * b and a * adjugate(b)
+RMAPI __m128 SimdMat2Multiply(__m128 a, __m128 b)
+{
+    return _mm_add_ps(_mm_mul_ps(a, SIMD_SWIZZLE(b, 0, 3, 0, 3)), _mm_mul_ps(SIMD_SWIZZLE(a, 1, 0, 3, 2), SIMD_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+RMAPI __m128 SimdMat2AdjugateMultiply(__m128 a, __m128 b)
+{
+    return _mm_sub_ps(_mm_mul_ps(SIMD_SWIZZLE(a, 3, 3, 0, 0), b), _mm_mul_ps(SIMD_SWIZZLE(a, 1, 1, 2, 2), SIMD_SWIZZLE(b, 2, 3, 0, 1)));
+}
+
+RMAPI __m128 SimdMat2MultiplyAdjugate(__m128 a, __m128 b)
+{
+    return _mm_sub_ps(_mm_mul_ps(a, SIMD_SWIZZLE(b, 3, 0, 3, 0)), _mm_mul_ps(SIMD_SWIZZLE(a, 1, 0, 3, 2), SIMD_SWIZZLE(b, 2, 1, 2, 1)));
+}
+#endif
+
 //----------------------------------------------------------------------------------
 // Module Functions Definition - Scalar math
 //----------------------------------------------------------------------------------
 
+// Sine for constant expressions, where sin() can't be called. Reduces to [-pi/4, pi/4], then a Taylor series that
+// is accurate to double precision there. Meant for the modest angles of projections and fixed rotations.
+RMCONSTEXPR double ConstexprSinReduced(double r)
+{
+    double r2 = r * r;
+    return r * (1.0 - r2 / 6.0 * (1.0 - r2 / 20.0 * (1.0 - r2 / 42.0 * (1.0 - r2 / 72.0 * (1.0 - r2 / 110.0 * (1.0 - r2 / 156.0 * (1.0 - r2 / 210.0 * (1.0 - r2 / 272.0))))))));
+}
+
+RMCONSTEXPR double ConstexprCosReduced(double r)
+{
+    double r2 = r * r;
+    return 1.0 - r2 / 2.0 * (1.0 - r2 / 12.0 * (1.0 - r2 / 30.0 * (1.0 - r2 / 56.0 * (1.0 - r2 / 90.0 * (1.0 - r2 / 132.0 * (1.0 - r2 / 182.0 * (1.0 - r2 / 240.0)))))));
+}
+
+RMCONSTEXPR double ConstexprSin(double x)
+{
+    // Nearest multiple of pi/2, subtracted in two parts so the remainder keeps its precision
+    long long quadrant = (long long)(x * 0.63661977236758134308 + ((x < 0.0) ? -0.5 : 0.5));
+    double r = (x - (double)quadrant * 1.5707963267948966) - (double)quadrant * 6.123233995736766e-17;
+
+    switch (quadrant & 3)
+    {
+    case 0: return ConstexprSinReduced(r);
+    case 1: return ConstexprCosReduced(r);
+    case 2: return -ConstexprSinReduced(r);
+    default: return -ConstexprCosReduced(r);
+    }
+}
+
+RMCONSTEXPR double ConstexprCos(double x)
+{
+    return ConstexprSin(x + 1.5707963267948966);
+}
+
+RMCONSTEXPR double ConstexprTan(double x)
+{
+    long long quadrant = (long long)(x * 0.63661977236758134308 + ((x < 0.0) ? -0.5 : 0.5));
+    double r = (x - (double)quadrant * 1.5707963267948966) - (double)quadrant * 6.123233995736766e-17;
+
+    // tan repeats every pi, and is -cot(r) in the odd quadrants
+    return (quadrant & 1) ? -ConstexprCosReduced(r) / ConstexprSinReduced(r) : ConstexprSinReduced(r) / ConstexprCosReduced(r);
+}
+
 // Random value between min and max (can be negative)
 RMAPI float Random(float min, float max)
 {
@@ -248,7 +453,7 @@ RMAPI float Random(float min, float max)
 }
 
 // Clamp float value
-RMAPI float Clamp(float value, float min, float max)
+RMCONSTEXPR float Clamp(float value, float min, float max)
 {
     float result = (value < min) ? min : value;
 
@@ -258,7 +463,7 @@ RMAPI float Clamp(float value, float min, float max)
 }
 
 // Calculate linear interpolation between two floats
-RMAPI float Lerp(float start, float end, float amount)
+RMCONSTEXPR float Lerp(float start, float end, float amount)
 {
     float result = start + amount * (end - start);
 
@@ -266,13 +471,13 @@ RMAPI float Lerp(float start, float end, float amount)
 }
 
 // 1d tri-linear interpolation
-RMAPI float Terp(float A, float B, float C, Vector3 t)
+RMCONSTEXPR float Terp(float A, float B, float C, Vector3 t)
 {
     return A * t.x + B * t.y + C * t.z;
 }
 
 // Normalize input value within input range
-RMAPI float Normalize(float value, float start, float end)
+RMCONSTEXPR float Normalize(float value, float start, float end)
 {
     float result = (value - start) / (end - start);
 
@@ -280,7 +485,7 @@ RMAPI float Normalize(float value, float start, float end)
 }
 
 // Remap input value within input range to output range
-RMAPI float Remap(float value, float inputStart, float inputEnd, float outputStart, float outputEnd)
+RMCONSTEXPR float Remap(float value, float inputStart, float inputEnd, float outputStart, float outputEnd)
 {
     float result = (value - inputStart) / (inputEnd - inputStart) * (outputEnd - outputStart) + outputStart;
 
@@ -308,7 +513,7 @@ RMAPI int Equals(float x, float y)
 //----------------------------------------------------------------------------------
 
 // Add two vectors (v1 + v2)
-RMAPI Vector2 Add(Vector2 v1, Vector2 v2)
+RMCONSTEXPR Vector2 Add(Vector2 v1, Vector2 v2)
 {
     Vector2 result = { v1.x + v2.x, v1.y + v2.y };
 
@@ -316,7 +521,7 @@ RMAPI Vector2 Add(Vector2 v1, Vector2 v2)
 }
 
 // Add vector and float value
-RMAPI Vector2 Add(Vector2 v, float add)
+RMCONSTEXPR Vector2 Add(Vector2 v, float add)
 {
     Vector2 result = { v.x + add, v.y + add };
 
@@ -324,7 +529,7 @@ RMAPI Vector2 Add(Vector2 v, float add)
 }
 
 // Subtract two vectors (v1 - v2)
-RMAPI Vector2 Subtract(Vector2 v1, Vector2 v2)
+RMCONSTEXPR Vector2 Subtract(Vector2 v1, Vector2 v2)
 {
     Vector2 result = { v1.x - v2.x, v1.y - v2.y };
 
@@ -332,7 +537,7 @@ RMAPI Vector2 Subtract(Vector2 v1, Vector2 v2)
 }
 
 // Subtract vector by float value
-RMAPI Vector2 Subtract(Vector2 v, float sub)
+RMCONSTEXPR Vector2 Subtract(Vector2 v, float sub)
 {
     Vector2 result = { v.x - sub, v.y - sub };
 
@@ -347,7 +552,7 @@ RMAPI float Length(Vector2 v)
 }
 
 // Calculate vector square length
-RMAPI float LengthSqr(Vector2 v)
+RMCONSTEXPR float LengthSqr(Vector2 v)
 {
     float result = (v.x * v.x) + (v.y * v.y);
 
@@ -355,14 +560,14 @@ RMAPI float LengthSqr(Vector2 v)
 }
 
 // Calculate two vectors dot product
-RMAPI float Dot(Vector2 v1, Vector2 v2)
+RMCONSTEXPR float Dot(Vector2 v1, Vector2 v2)
 {
     float result = (v1.x * v2.x + v1.y * v2.y);
 
     return result;
 }
 
-RMAPI float Cross(Vector2 v1, Vector2 v2)
+RMCONSTEXPR float Cross(Vector2 v1, Vector2 v2)
 {
     float result = v1.x * v2.y - v1.y * v2.x;
 
@@ -378,7 +583,7 @@ RMAPI float Distance(Vector2 v1, Vector2 v2)
 }
 
 // Calculate square distance between two vectors
-RMAPI float DistanceSqr(Vector2 v1, Vector2 v2)
+RMCONSTEXPR float DistanceSqr(Vector2 v1, Vector2 v2)
 {
     float result = ((v1.x - v2.x) * (v1.x - v2.x) + (v1.y - v2.y) * (v1.y - v2.y));
 
@@ -386,7 +591,7 @@ RMAPI float DistanceSqr(Vector2 v1, Vector2 v2)
 }
 
 // -1 if below zero, +1 if above zero
-RMAPI float Sign(float value)
+RMCONSTEXPR float Sign(float value)
 {
     float result = (value < 0.0f) ? -1.0f : 1.0f;
 
@@ -433,7 +638,7 @@ RMAPI float SignedAngle(Vector2 from, Vector2 to)
 }
 
 // Scale vector (multiply by value)
-RMAPI Vector2 Scale(Vector2 v, float scale)
+RMCONSTEXPR Vector2 Scale(Vector2 v, float scale)
 {
     Vector2 result = { v.x * scale, v.y * scale };
 
@@ -441,21 +646,21 @@ RMAPI Vector2 Scale(Vector2 v, float scale)
 }
 
 // Project v1 onto v2
-RMAPI Vector2 Project(Vector2 v1, Vector2 v2)
+RMCONSTEXPR Vector2 Project(Vector2 v1, Vector2 v2)
 {
     float t = Dot(v1, v2) / Dot(v2, v2);
     return { t * v2.x, t * v2.y };
 }
 
 // Scalar projection of v1 onto v2
-RMAPI float ProjectScalar(Vector2 v1, Vector2 v2)
+RMCONSTEXPR float ProjectScalar(Vector2 v1, Vector2 v2)
 {
     float t = Dot(v1, v2) / Dot(v2, v2);
     return t;
 }
 
 // Projects point P onto line AB
-RMAPI Vector2 ProjectPointLine(Vector2 A, Vector2 B, Vector2 P)
+RMCONSTEXPR Vector2 ProjectPointLine(Vector2 A, Vector2 B, Vector2 P)
 {
     Vector2 AB = Subtract(B, A);
     float t = Dot(Subtract(P, A), AB) / Dot(AB, AB);
@@ -463,7 +668,7 @@ RMAPI Vector2 ProjectPointLine(Vector2 A, Vector2 B, Vector2 P)
 }
 
 // Multiply vector by vector
-RMAPI Vector2 Multiply(Vector2 v1, Vector2 v2)
+RMCONSTEXPR Vector2 Multiply(Vector2 v1, Vector2 v2)
 {
     Vector2 result = { v1.x * v2.x, v1.y * v2.y };
 
@@ -471,7 +676,7 @@ RMAPI Vector2 Multiply(Vector2 v1, Vector2 v2)
 }
 
 // Negate vector
-RMAPI Vector2 Negate(Vector2 v)
+RMCONSTEXPR Vector2 Negate(Vector2 v)
 {
     Vector2 result = { -v.x, -v.y };
 
@@ -479,7 +684,7 @@ RMAPI Vector2 Negate(Vector2 v)
 }
 
 // Divide vector by vector
-RMAPI Vector2 Divide(Vector2 v1, Vector2 v2)
+RMCONSTEXPR Vector2 Divide(Vector2 v1, Vector2 v2)
 {
     Vector2 result = { v1.x / v2.x, v1.y / v2.y };
 
@@ -503,7 +708,7 @@ RMAPI Vector2 Normalize(Vector2 v)
 }
 
 // Transforms a Vector2 by a given Matrix
-RMAPI Vector2 Multiply(Vector2 v, Matrix mat)
+RMCONSTEXPR Vector2 Multiply(Vector2 v, Matrix mat)
 {
     Vector2 result = { 0 };
 
@@ -518,7 +723,7 @@ RMAPI Vector2 Multiply(Vector2 v, Matrix mat)
 }
 
 // Calculate linear interpolation between two vectors
-RMAPI Vector2 Lerp(Vector2 v1, Vector2 v2, float amount)
+RMCONSTEXPR Vector2 Lerp(Vector2 v1, Vector2 v2, float amount)
 {
     Vector2 result = { 0 };
 
@@ -529,13 +734,13 @@ RMAPI Vector2 Lerp(Vector2 v1, Vector2 v2, float amount)
 }
 
 // 2d tri-linear interpolation
-RMAPI Vector2 Terp(Vector2 A, Vector2 B, Vector2 C, Vector3 t)
+RMCONSTEXPR Vector2 Terp(Vector2 A, Vector2 B, Vector2 C, Vector3 t)
 {
     return A * t.x + B * t.y + C * t.z;
 }
 
 // Calculate reflected vector to normal
-RMAPI Vector2 Reflect(Vector2 v, Vector2 normal)
+RMCONSTEXPR Vector2 Reflect(Vector2 v, Vector2 normal)
 {
     Vector2 result = { 0 };
 
@@ -588,7 +793,7 @@ RMAPI Vector2 RotateTowards(Vector2 from, Vector2 to, float maxRadians)
 }
 
 // Invert the given vector
-RMAPI Vector2 Invert(Vector2 v)
+RMCONSTEXPR Vector2 Invert(Vector2 v)
 {
     Vector2 result = { 1.0f / v.x, 1.0f / v.y };
 
@@ -648,7 +853,7 @@ RMAPI bool Equals(Vector2 p, Vector2 q)
 //----------------------------------------------------------------------------------
 
 // Add two vectors
-RMAPI Vector3 Add(Vector3 v1, Vector3 v2)
+RMCONSTEXPR Vector3 Add(Vector3 v1, Vector3 v2)
 {
     Vector3 result = { v1.x + v2.x, v1.y + v2.y, v1.z + v2.z };
 
@@ -656,7 +861,7 @@ RMAPI Vector3 Add(Vector3 v1, Vector3 v2)
 }
 
 // Add vector and float value
-RMAPI Vector3 Add(Vector3 v, float add)
+RMCONSTEXPR Vector3 Add(Vector3 v, float add)
 {
     Vector3 result = { v.x + add, v.y + add, v.z + add };
 
@@ -664,7 +869,7 @@ RMAPI Vector3 Add(Vector3 v, float add)
 }
 
 // Subtract two vectors
-RMAPI Vector3 Subtract(Vector3 v1, Vector3 v2)
+RMCONSTEXPR Vector3 Subtract(Vector3 v1, Vector3 v2)
 {
     Vector3 result = { v1.x - v2.x, v1.y - v2.y, v1.z - v2.z };
 
@@ -672,7 +877,7 @@ RMAPI Vector3 Subtract(Vector3 v1, Vector3 v2)
 }
 
 // Subtract vector by float value
-RMAPI Vector3 Subtract(Vector3 v, float sub)
+RMCONSTEXPR Vector3 Subtract(Vector3 v, float sub)
 {
     Vector3 result = { v.x - sub, v.y - sub, v.z - sub };
 
@@ -680,7 +885,7 @@ RMAPI Vector3 Subtract(Vector3 v, float sub)
 }
 
 // Multiply vector by scalar
-RMAPI Vector3 Scale(Vector3 v, float scalar)
+RMCONSTEXPR Vector3 Scale(Vector3 v, float scalar)
 {
     Vector3 result = { v.x * scalar, v.y * scalar, v.z * scalar };
 
@@ -688,7 +893,7 @@ RMAPI Vector3 Scale(Vector3 v, float scalar)
 }
 
 // Multiply vector by vector
-RMAPI Vector3 Multiply(Vector3 v1, Vector3 v2)
+RMCONSTEXPR Vector3 Multiply(Vector3 v1, Vector3 v2)
 {
     Vector3 result = { v1.x * v2.x, v1.y * v2.y, v1.z * v2.z };
 
@@ -696,7 +901,7 @@ RMAPI Vector3 Multiply(Vector3 v1, Vector3 v2)
 }
 
 // Calculate two vectors cross product
-RMAPI Vector3 Cross(Vector3 v1, Vector3 v2)
+RMCONSTEXPR Vector3 Cross(Vector3 v1, Vector3 v2)
 {
     Vector3 result = { v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x };
 
@@ -741,7 +946,7 @@ RMAPI float Length(const Vector3 v)
 }
 
 // Calculate vector square length
-RMAPI float LengthSqr(const Vector3 v)
+RMCONSTEXPR float LengthSqr(const Vector3 v)
 {
     float result = v.x * v.x + v.y * v.y + v.z * v.z;
 
@@ -749,7 +954,7 @@ RMAPI float LengthSqr(const Vector3 v)
 }
 
 // Calculate two vectors dot product
-RMAPI float Dot(Vector3 v1, Vector3 v2)
+RMCONSTEXPR float Dot(Vector3 v1, Vector3 v2)
 {
     float result = (v1.x * v2.x + v1.y * v2.y + v1.z * v2.z);
 
@@ -770,7 +975,7 @@ RMAPI float Distance(Vector3 v1, Vector3 v2)
 }
 
 // Calculate square distance between two vectors
-RMAPI float DistanceSqr(Vector3 v1, Vector3 v2)
+RMCONSTEXPR float DistanceSqr(Vector3 v1, Vector3 v2)
 {
     float result = 0.0f;
 
@@ -783,21 +988,21 @@ RMAPI float DistanceSqr(Vector3 v1, Vector3 v2)
 }
 
 // Project v1 onto v2
-RMAPI Vector3 Project(Vector3 v1, Vector3 v2)
+RMCONSTEXPR Vector3 Project(Vector3 v1, Vector3 v2)
 {
     float t = Dot(v1, v2) / Dot(v2, v2);
     return { t * v2.x, t * v2.y, t * v2.z };
 }
 
 // Scalar projection of v1 onto v2
-RMAPI float ProjectScalar(Vector3 v1, Vector3 v2)
+RMCONSTEXPR float ProjectScalar(Vector3 v1, Vector3 v2)
 {
     float t = Dot(v1, v2) / Dot(v2, v2);
     return t;
 }
 
 // Returns the point on line AB nearest to point P
-RMAPI Vector3 ProjectPointLine(Vector3 A, Vector3 B, Vector3 P)
+RMCONSTEXPR Vector3 ProjectPointLine(Vector3 A, Vector3 B, Vector3 P)
 {
     Vector3 AB = Subtract(B, A);
     float t = Dot(Subtract(P, A), AB) / Dot(AB, AB);
@@ -818,7 +1023,7 @@ RMAPI float Angle(Vector3 v1, Vector3 v2)
 }
 
 // Negate provided vector (invert direction)
-RMAPI Vector3 Negate(Vector3 v)
+RMCONSTEXPR Vector3 Negate(Vector3 v)
 {
     Vector3 result = { -v.x, -v.y, -v.z };
 
@@ -826,7 +1031,7 @@ RMAPI Vector3 Negate(Vector3 v)
 }
 
 // Divide vector by vector
-RMAPI Vector3 Divide(Vector3 v1, Vector3 v2)
+RMCONSTEXPR Vector3 Divide(Vector3 v1, Vector3 v2)
 {
     Vector3 result = { v1.x / v2.x, v1.y / v2.y, v1.z / v2.z };
 
@@ -885,7 +1090,7 @@ RMAPI void OrthoNormalize(Vector3* v1, Vector3* v2)
 }
 
 // Transforms a Vector3 by a given Matrix
-RMAPI Vector3 Multiply(Vector3 v, Matrix mat)
+RMCONSTEXPR Vector3 Multiply(Vector3 v, Matrix mat)
 {
     Vector3 result = { 0 };
 
@@ -901,7 +1106,7 @@ RMAPI Vector3 Multiply(Vector3 v, Matrix mat)
 }
 
 // Transform a vector by quaternion rotation
-RMAPI Vector3 Rotate(Vector3 v, Quaternion q)
+RMCONSTEXPR Vector3 Rotate(Vector3 v, Quaternion q)
 {
     Vector3 result = { 0 };
 
@@ -965,7 +1170,7 @@ RMAPI Vector3 Rotate(Vector3 v, Vector3 axis, float angle)
 }
 
 // Calculate linear interpolation between two vectors
-RMAPI Vector3 Lerp(Vector3 v1, Vector3 v2, float amount)
+RMCONSTEXPR Vector3 Lerp(Vector3 v1, Vector3 v2, float amount)
 {
     Vector3 result = { 0 };
 
@@ -977,13 +1182,13 @@ RMAPI Vector3 Lerp(Vector3 v1, Vector3 v2, float amount)
 }
 
 // 3d tri-linear interpolation
-RMAPI Vector3 Terp(Vector3 A, Vector3 B, Vector3 C, Vector3 t)
+RMCONSTEXPR Vector3 Terp(Vector3 A, Vector3 B, Vector3 C, Vector3 t)
 {
     return A * t.x + B * t.y + C * t.z;
 }
 
 // Calculate reflected vector to normal
-RMAPI Vector3 Reflect(Vector3 v, Vector3 normal)
+RMCONSTEXPR Vector3 Reflect(Vector3 v, Vector3 normal)
 {
     Vector3 result = { 0 };
 
@@ -1026,7 +1231,7 @@ RMAPI Vector3 Max(Vector3 v1, Vector3 v2)
 
 // Compute barycenter coordinates (u, v, w) for point p with respect to triangle (a, b, c)
 // NOTE: Assumes P is on the plane of the triangle
-RMAPI Vector3 Barycenter(Vector3 p, Vector3 a, Vector3 b, Vector3 c)
+RMCONSTEXPR Vector3 Barycenter(Vector3 p, Vector3 a, Vector3 b, Vector3 c)
 {
     Vector3 result = { 0 };
 
@@ -1050,7 +1255,7 @@ RMAPI Vector3 Barycenter(Vector3 p, Vector3 a, Vector3 b, Vector3 c)
 
 // Projects a Vector3 from screen space into object space
 // NOTE: We are avoiding calling other raymath functions despite available
-RMAPI Vector3 Unproject(Vector3 source, Matrix projection, Matrix view)
+RMCONSTEXPR Vector3 Unproject(Vector3 source, Matrix projection, Matrix view)
 {
     Vector3 result = { 0 };
 
@@ -1133,7 +1338,7 @@ RMAPI Vector3 Unproject(Vector3 source, Matrix projection, Matrix view)
 }
 
 // Invert the given vector
-RMAPI Vector3 Invert(Vector3 v)
+RMCONSTEXPR Vector3 Invert(Vector3 v)
 {
     Vector3 result = { 1.0f / v.x, 1.0f / v.y, 1.0f / v.z };
 
@@ -1223,7 +1428,7 @@ RMAPI Vector3 Refract(Vector3 v, Vector3 n, float r)
 //----------------------------------------------------------------------------------
 
 // Compute matrix determinant
-RMAPI float Determinant(Matrix mat)
+RMCONSTEXPR float Determinant(Matrix mat)
 {
     float result = 0.0f;
 
@@ -1244,7 +1449,7 @@ RMAPI float Determinant(Matrix mat)
 }
 
 // Get the trace of the matrix (sum of the values along the diagonal)
-RMAPI float Trace(Matrix mat)
+RMCONSTEXPR float Trace(Matrix mat)
 {
     float result = (mat.m0 + mat.m5 + mat.m10 + mat.m15);
 
@@ -1252,7 +1457,7 @@ RMAPI float Trace(Matrix mat)
 }
 
 // Transposes provided matrix
-RMAPI Matrix Transpose(Matrix mat)
+RMCONSTEXPR Matrix Transpose(Matrix mat)
 {
     Matrix result = { 0 };
 
@@ -1281,6 +1486,55 @@ RMAPI Matrix Invert(Matrix mat)
 {
     Matrix result = { 0 };
 
+#ifdef VECTOR_MATH_USE_SSE
+    // Block inverse over the four 2x2 sub-matrices A B / C D. Inverting the matrix as it is laid out in memory gives
+    // the same result, since the inverse of a transpose is the transpose of the inverse.
+    __m128 rows[4];
+    SimdLoadRows(mat, rows);
+
+    __m128 A = _mm_movelh_ps(rows[0], rows[1]);
+    __m128 B = _mm_movehl_ps(rows[1], rows[0]);
+    __m128 C = _mm_movelh_ps(rows[2], rows[3]);
+    __m128 D = _mm_movehl_ps(rows[3], rows[2]);
+
+    // Determinants of A, B, C and D
+    __m128 subDeterminants = _mm_sub_ps(
+        _mm_mul_ps(SIMD_SHUFFLE(rows[0], rows[2], 0, 2, 0, 2), SIMD_SHUFFLE(rows[1], rows[3], 1, 3, 1, 3)),
+        _mm_mul_ps(SIMD_SHUFFLE(rows[0], rows[2], 1, 3, 1, 3), SIMD_SHUFFLE(rows[1], rows[3], 0, 2, 0, 2)));
+
+    __m128 detA = SIMD_SWIZZLE(subDeterminants, 0, 0, 0, 0);
+    __m128 detB = SIMD_SWIZZLE(subDeterminants, 1, 1, 1, 1);
+    __m128 detC = SIMD_SWIZZLE(subDeterminants, 2, 2, 2, 2);
+    __m128 detD = SIMD_SWIZZLE(subDeterminants, 3, 3, 3, 3);
+
+    __m128 adjDC = SimdMat2AdjugateMultiply(D, C);
+    __m128 adjAB = SimdMat2AdjugateMultiply(A, B);
+
+    // Adjugates of the four blocks of the result
+    __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), SimdMat2Multiply(B, adjDC));
+    __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), SimdMat2Multiply(C, adjAB));
+    __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), SimdMat2MultiplyAdjugate(D, adjAB));
+    __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), SimdMat2MultiplyAdjugate(A, adjDC));
+
+    // det = |A||D| + |B||C| - trace(adj(A)B adj(D)C)
+    __m128 determinant = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+    determinant = _mm_sub_ps(determinant, SimdHorizontalSum(_mm_mul_ps(adjAB, SIMD_SWIZZLE(adjDC, 0, 2, 1, 3))));
+
+    __m128 invDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+    X = _mm_mul_ps(X, invDet);
+    Y = _mm_mul_ps(Y, invDet);
+    Z = _mm_mul_ps(Z, invDet);
+    W = _mm_mul_ps(W, invDet);
+
+    // Undo the adjugate and put the blocks back into rows
+    rows[0] = SIMD_SHUFFLE(X, Y, 3, 1, 3, 1);
+    rows[1] = SIMD_SHUFFLE(X, Y, 2, 0, 2, 0);
+    rows[2] = SIMD_SHUFFLE(Z, W, 3, 1, 3, 1);
+    rows[3] = SIMD_SHUFFLE(Z, W, 2, 0, 2, 0);
+    SimdStoreRows(result, rows);
+
+    return result;
+#else
     // Cache the matrix values (speed optimization)
     float a00 = mat.m0, a01 = mat.m1, a02 = mat.m2, a03 = mat.m3;
     float a10 = mat.m4, a11 = mat.m5, a12 = mat.m6, a13 = mat.m7;
@@ -1321,10 +1575,11 @@ RMAPI Matrix Invert(Matrix mat)
     result.m15 = (a20 * b03 - a21 * b01 + a22 * b00) * invDet;
 
     return result;
+#endif
 }
 
 // Get identity matrix
-RMAPI Matrix MatrixIdentity(void)
+RMCONSTEXPR Matrix MatrixIdentity(void)
 {
     Matrix result = { 1.0f, 0.0f, 0.0f, 0.0f,
                       0.0f, 1.0f, 0.0f, 0.0f,
@@ -1335,7 +1590,7 @@ RMAPI Matrix MatrixIdentity(void)
 }
 
 // Add two matrices
-RMAPI Matrix Add(Matrix left, Matrix right)
+RMCONSTEXPR Matrix Add(Matrix left, Matrix right)
 {
     Matrix result = { 0 };
 
@@ -1360,7 +1615,7 @@ RMAPI Matrix Add(Matrix left, Matrix right)
 }
 
 // Subtract two matrices (left - right)
-RMAPI Matrix Subtract(Matrix left, Matrix right)
+RMCONSTEXPR Matrix Subtract(Matrix left, Matrix right)
 {
     Matrix result = { 0 };
 
@@ -1390,6 +1645,24 @@ RMAPI Matrix Multiply(Matrix left, Matrix right)
 {
     Matrix result = { 0 };
 
+#ifdef VECTOR_MATH_USE_SSE
+    // Each row of the result is the rows of left, weighted by one row of right. Summed in the same order as below.
+    __m128 leftRows[4];
+    __m128 rightRows[4];
+    __m128 resultRows[4];
+    SimdLoadRows(left, leftRows);
+    SimdLoadRows(right, rightRows);
+
+    for (int i = 0; i < 4; i++)
+    {
+        __m128 row = _mm_mul_ps(SIMD_SWIZZLE(rightRows[i], 0, 0, 0, 0), leftRows[0]);
+        row = SimdMultiplyAdd(SIMD_SWIZZLE(rightRows[i], 1, 1, 1, 1), leftRows[1], row);
+        row = SimdMultiplyAdd(SIMD_SWIZZLE(rightRows[i], 2, 2, 2, 2), leftRows[2], row);
+        resultRows[i] = SimdMultiplyAdd(SIMD_SWIZZLE(rightRows[i], 3, 3, 3, 3), leftRows[3], row);
+    }
+
+    SimdStoreRows(result, resultRows);
+#else
     result.m0 = left.m0 * right.m0 + left.m1 * right.m4 + left.m2 * right.m8 + left.m3 * right.m12;
     result.m1 = left.m0 * right.m1 + left.m1 * right.m5 + left.m2 * right.m9 + left.m3 * right.m13;
     result.m2 = left.m0 * right.m2 + left.m1 * right.m6 + left.m2 * right.m10 + left.m3 * right.m14;
@@ -1406,12 +1679,13 @@ RMAPI Matrix Multiply(Matrix left, Matrix right)
     result.m13 = left.m12 * right.m1 + left.m13 * right.m5 + left.m14 * right.m9 + left.m15 * right.m13;
     result.m14 = left.m12 * right.m2 + left.m13 * right.m6 + left.m14 * right.m10 + left.m15 * right.m14;
     result.m15 = left.m12 * right.m3 + left.m13 * right.m7 + left.m14 * right.m11 + left.m15 * right.m15;
+#endif
 
     return result;
 }
 
 // Get translation matrix
-RMAPI Matrix Translate(float x, float y, float z)
+RMCONSTEXPR Matrix Translate(float x, float y, float z)
 {
     Matrix result = { 1.0f, 0.0f, 0.0f, x,
                       0.0f, 1.0f, 0.0f, y,
@@ -1595,7 +1869,7 @@ RMAPI Matrix RotateZYX(Vector3 angle)
 }
 
 // Get scaling matrix
-RMAPI Matrix Scale(float x, float y, float z)
+RMCONSTEXPR Matrix Scale(float x, float y, float z)
 {
     Matrix result = { x, 0.0f, 0.0f, 0.0f,
                       0.0f, y, 0.0f, 0.0f,
@@ -1606,7 +1880,7 @@ RMAPI Matrix Scale(float x, float y, float z)
 }
 
 // Get perspective projection matrix
-RMAPI Matrix Frustum(double left, double right, double bottom, double top, double near, double far)
+RMCONSTEXPR Matrix Frustum(double left, double right, double bottom, double top, double near, double far)
 {
     Matrix result = { 0 };
 
@@ -1639,11 +1913,11 @@ RMAPI Matrix Frustum(double left, double right, double bottom, double top, doubl
 
 // Get perspective projection matrix
 // NOTE: Fovy angle must be provided in radians
-RMAPI Matrix Perspective(double fovy, double aspect, double near, double far)
+RMCONSTEXPR Matrix Perspective(double fovy, double aspect, double near, double far)
 {
     Matrix result = { 0 };
 
-    double top = near * tan(fovy * 0.5);
+    double top = near * ConstexprTan(fovy * 0.5);
     double bottom = -top;
     double right = top * aspect;
     double left = -right;
@@ -1665,7 +1939,7 @@ RMAPI Matrix Perspective(double fovy, double aspect, double near, double far)
 }
 
 // Get orthographic projection matrix
-RMAPI Matrix Ortho(double left, double right, double bottom, double top, double near, double far)
+RMCONSTEXPR Matrix Ortho(double left, double right, double bottom, double top, double near, double far)
 {
     Matrix result = { 0 };
 
@@ -1777,7 +2051,7 @@ inline Vector3 Clip(Matrix m, Vector3 v)
 //----------------------------------------------------------------------------------
 
 // Add two quaternions
-RMAPI Quaternion Add(Quaternion q1, Quaternion q2)
+RMCONSTEXPR Quaternion Add(Quaternion q1, Quaternion q2)
 {
     Quaternion result = { q1.x + q2.x, q1.y + q2.y, q1.z + q2.z, q1.w + q2.w };
 
@@ -1785,7 +2059,7 @@ RMAPI Quaternion Add(Quaternion q1, Quaternion q2)
 }
 
 // Add quaternion and float value
-RMAPI Quaternion Add(Quaternion q, float add)
+RMCONSTEXPR Quaternion Add(Quaternion q, float add)
 {
     Quaternion result = { q.x + add, q.y + add, q.z + add, q.w + add };
 
@@ -1793,7 +2067,7 @@ RMAPI Quaternion Add(Quaternion q, float add)
 }
 
 // Subtract two quaternions
-RMAPI Quaternion Subtract(Quaternion q1, Quaternion q2)
+RMCONSTEXPR Quaternion Subtract(Quaternion q1, Quaternion q2)
 {
     Quaternion result = { q1.x - q2.x, q1.y - q2.y, q1.z - q2.z, q1.w - q2.w };
 
@@ -1801,7 +2075,7 @@ RMAPI Quaternion Subtract(Quaternion q1, Quaternion q2)
 }
 
 // Subtract quaternion and float value
-RMAPI Quaternion Subtract(Quaternion q, float sub)
+RMCONSTEXPR Quaternion Subtract(Quaternion q, float sub)
 {
     Quaternion result = { q.x - sub, q.y - sub, q.z - sub, q.w - sub };
 
@@ -1809,7 +2083,7 @@ RMAPI Quaternion Subtract(Quaternion q, float sub)
 }
 
 // Get identity quaternion
-RMAPI Quaternion QuaternionIdentity(void)
+RMCONSTEXPR Quaternion QuaternionIdentity(void)
 {
     Quaternion result = { 0.0f, 0.0f, 0.0f, 1.0f };
 
@@ -1829,6 +2103,15 @@ RMAPI Quaternion Normalize(Quaternion q)
 {
     Quaternion result = { 0 };
 
+#ifdef VECTOR_MATH_USE_SSE
+    __m128 v = _mm_loadu_ps(&q.x);
+    __m128 length = _mm_sqrt_ps(SimdHorizontalSum(_mm_mul_ps(v, v)));
+
+    // A zero length leaves the quaternion as it is, like below
+    __m128 isZero = _mm_cmpeq_ps(length, _mm_setzero_ps());
+    length = _mm_or_ps(_mm_andnot_ps(isZero, length), _mm_and_ps(isZero, _mm_set1_ps(1.0f)));
+    _mm_storeu_ps(&result.x, _mm_mul_ps(v, _mm_div_ps(_mm_set1_ps(1.0f), length)));
+#else
     float length = sqrtf(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
     if (length == 0.0f) length = 1.0f;
     float ilength = 1.0f / length;
@@ -1837,12 +2120,13 @@ RMAPI Quaternion Normalize(Quaternion q)
     result.y = q.y * ilength;
     result.z = q.z * ilength;
     result.w = q.w * ilength;
+#endif
 
     return result;
 }
 
 // Invert provided quaternion
-RMAPI Quaternion Invert(Quaternion q)
+RMCONSTEXPR Quaternion Invert(Quaternion q)
 {
     Quaternion result = q;
 
@@ -1866,6 +2150,18 @@ RMAPI Quaternion Multiply(Quaternion q1, Quaternion q2)
 {
     Quaternion result = { 0 };
 
+#ifdef VECTOR_MATH_USE_SSE
+    __m128 a = _mm_loadu_ps(&q1.x);
+    __m128 b = _mm_loadu_ps(&q2.x);
+    __m128 flipW = _mm_setr_ps(1.0f, 1.0f, 1.0f, -1.0f);
+
+    // The same four products as below, one column of terms at a time
+    __m128 sum = _mm_mul_ps(SIMD_SWIZZLE(a, 3, 3, 3, 3), b);
+    sum = SimdMultiplyAdd(_mm_mul_ps(SIMD_SWIZZLE(a, 0, 1, 2, 0), SIMD_SWIZZLE(b, 3, 3, 3, 0)), flipW, sum);
+    sum = SimdMultiplyAdd(_mm_mul_ps(SIMD_SWIZZLE(a, 1, 2, 0, 1), SIMD_SWIZZLE(b, 2, 0, 1, 1)), flipW, sum);
+    sum = _mm_sub_ps(sum, _mm_mul_ps(SIMD_SWIZZLE(a, 2, 0, 1, 2), SIMD_SWIZZLE(b, 1, 2, 0, 2)));
+    _mm_storeu_ps(&result.x, sum);
+#else
     float qax = q1.x, qay = q1.y, qaz = q1.z, qaw = q1.w;
     float qbx = q2.x, qby = q2.y, qbz = q2.z, qbw = q2.w;
 
@@ -1873,12 +2169,13 @@ RMAPI Quaternion Multiply(Quaternion q1, Quaternion q2)
     result.y = qay * qbw + qaw * qby + qaz * qbx - qax * qbz;
     result.z = qaz * qbw + qaw * qbz + qax * qby - qay * qbx;
     result.w = qaw * qbw - qax * qbx - qay * qby - qaz * qbz;
+#endif
 
     return result;
 }
 
 // Scale quaternion by float value
-RMAPI Quaternion Scale(Quaternion q, float mul)
+RMCONSTEXPR Quaternion Scale(Quaternion q, float mul)
 {
     Quaternion result = { 0 };
 
@@ -1891,7 +2188,7 @@ RMAPI Quaternion Scale(Quaternion q, float mul)
 }
 
 // Divide two quaternions
-RMAPI Quaternion Divide(Quaternion q1, Quaternion q2)
+RMCONSTEXPR Quaternion Divide(Quaternion q1, Quaternion q2)
 {
     Quaternion result = { q1.x / q2.x, q1.y / q2.y, q1.z / q2.z, q1.w / q2.w };
 
@@ -1899,7 +2196,7 @@ RMAPI Quaternion Divide(Quaternion q1, Quaternion q2)
 }
 
 // Calculate linear interpolation between two quaternions
-RMAPI Quaternion Lerp(Quaternion q1, Quaternion q2, float amount)
+RMCONSTEXPR Quaternion Lerp(Quaternion q1, Quaternion q2, float amount)
 {
     Quaternion result = { 0 };
 
@@ -2071,7 +2368,7 @@ RMAPI Quaternion FromMatrix(Matrix mat)
 }
 
 // Get a matrix for a given quaternion
-RMAPI Matrix ToMatrix(Quaternion q)
+RMCONSTEXPR Matrix ToMatrix(Quaternion q)
 {
     Matrix result = { 1.0f, 0.0f, 0.0f, 0.0f,
                       0.0f, 1.0f, 0.0f, 0.0f,
@@ -2237,10 +2534,23 @@ RMAPI Quaternion Multiply(Quaternion q, Matrix mat)
 {
     Quaternion result = { 0 };
 
+#ifdef VECTOR_MATH_USE_SSE
+    // Transposing the rows gives the columns, which are weighted by q and summed in the same order as below.
+    __m128 columns[4];
+    SimdLoadRows(mat, columns);
+    _MM_TRANSPOSE4_PS(columns[0], columns[1], columns[2], columns[3]);
+
+    __m128 sum = _mm_mul_ps(columns[0], _mm_set1_ps(q.x));
+    sum = SimdMultiplyAdd(columns[1], _mm_set1_ps(q.y), sum);
+    sum = SimdMultiplyAdd(columns[2], _mm_set1_ps(q.z), sum);
+    sum = SimdMultiplyAdd(columns[3], _mm_set1_ps(q.w), sum);
+    _mm_storeu_ps(&result.x, sum);
+#else
     result.x = mat.m0 * q.x + mat.m4 * q.y + mat.m8 * q.z + mat.m12 * q.w;
     result.y = mat.m1 * q.x + mat.m5 * q.y + mat.m9 * q.z + mat.m13 * q.w;
     result.z = mat.m2 * q.x + mat.m6 * q.y + mat.m10 * q.z + mat.m14 * q.w;
     result.w = mat.m3 * q.x + mat.m7 * q.y + mat.m11 * q.z + mat.m15 * q.w;
+#endif
 
     return result;
 }
@@ -2260,31 +2570,709 @@ RMAPI int Equals(Quaternion p, Quaternion q)
     return result;
 }
 
+//----------------------------------------------------------------------------------
+// Module Functions Definition - TRS math
+//----------------------------------------------------------------------------------
+
+// Get identity TRS
+RMCONSTEXPR TRS TRSIdentity(void)
+{
+    TRS result = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f } };
+
+    return result;
+}
+
+// Get the TRS that applies a, then b. Same order as multiplying their matrices.
+// NOTE: Only exact when b's scale is uniform, a non-uniform parent scale on a rotated child would need shear
+RMAPI TRS Multiply(TRS a, TRS b)
+{
+    TRS result = { 0 };
+
+    result.scale = Multiply(a.scale, b.scale);
+    result.rotation = Multiply(b.rotation, a.rotation);
+    result.translation = Add(Rotate(Multiply(a.translation, b.scale), b.rotation), b.translation);
+
+    return result;
+}
+
+// Invert provided TRS, the rotation must be normalized
+// NOTE: Only exact when the scale is uniform, for the same reason as Multiply()
+RMCONSTEXPR TRS Invert(TRS t)
+{
+    TRS result = { 0 };
+
+    result.scale = { 1.0f / t.scale.x, 1.0f / t.scale.y, 1.0f / t.scale.z };
+    result.rotation = { -t.rotation.x, -t.rotation.y, -t.rotation.z, t.rotation.w };
+    result.translation = Negate(Multiply(Rotate(t.translation, result.rotation), result.scale));
+
+    return result;
+}
+
+// Transform a point by a TRS
+RMCONSTEXPR Vector3 Multiply(Vector3 v, TRS t)
+{
+    return Add(Rotate(Multiply(v, t.scale), t.rotation), t.translation);
+}
+
+// Get a matrix for a given TRS, the rotation must be normalized
+RMCONSTEXPR Matrix ToMatrix(TRS t)
+{
+    Matrix result = ToMatrix(t.rotation);
+
+    result.m0 *= t.scale.x;
+    result.m1 *= t.scale.x;
+    result.m2 *= t.scale.x;
+
+    result.m4 *= t.scale.y;
+    result.m5 *= t.scale.y;
+    result.m6 *= t.scale.y;
+
+    result.m8 *= t.scale.z;
+    result.m9 *= t.scale.z;
+    result.m10 *= t.scale.z;
+
+    result.m12 = t.translation.x;
+    result.m13 = t.translation.y;
+    result.m14 = t.translation.z;
+
+    return result;
+}
+
+// Split a matrix into translation, rotation and scale
+// NOTE: Any shear or projection in the matrix is lost, and a mirrored matrix gets a negative x scale
+RMAPI TRS ToTRS(Matrix mat)
+{
+    TRS result = { 0 };
+
+    result.translation = { mat.m12, mat.m13, mat.m14 };
+    result.scale.x = sqrtf(mat.m0 * mat.m0 + mat.m1 * mat.m1 + mat.m2 * mat.m2);
+    result.scale.y = sqrtf(mat.m4 * mat.m4 + mat.m5 * mat.m5 + mat.m6 * mat.m6);
+    result.scale.z = sqrtf(mat.m8 * mat.m8 + mat.m9 * mat.m9 + mat.m10 * mat.m10);
+
+    float determinant = mat.m0 * (mat.m5 * mat.m10 - mat.m6 * mat.m9) - mat.m4 * (mat.m1 * mat.m10 - mat.m2 * mat.m9) + mat.m8 * (mat.m1 * mat.m6 - mat.m2 * mat.m5);
+    if (determinant < 0.0f) result.scale.x = -result.scale.x;
+
+    // Divide the scale back out of the axes, leaving a pure rotation
+    Matrix rotation = MatrixIdentity();
+    float invX = (result.scale.x != 0.0f) ? 1.0f / result.scale.x : 0.0f;
+    float invY = (result.scale.y != 0.0f) ? 1.0f / result.scale.y : 0.0f;
+    float invZ = (result.scale.z != 0.0f) ? 1.0f / result.scale.z : 0.0f;
+
+    rotation.m0 = mat.m0 * invX;
+    rotation.m1 = mat.m1 * invX;
+    rotation.m2 = mat.m2 * invX;
+    rotation.m4 = mat.m4 * invY;
+    rotation.m5 = mat.m5 * invY;
+    rotation.m6 = mat.m6 * invY;
+    rotation.m8 = mat.m8 * invZ;
+    rotation.m9 = mat.m9 * invZ;
+    rotation.m10 = mat.m10 * invZ;
+
+    result.rotation = Normalize(FromMatrix(rotation));
+
+    return result;
+}
+
+// Check whether two given TRS are almost equal
+RMAPI int Equals(TRS a, TRS b)
+{
+    int result = Equals(a.translation, b.translation) && Equals(a.rotation, b.rotation) && Equals(a.scale, b.scale);
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Fast approximate math
+//----------------------------------------------------------------------------------
+
+// Approximate versions of the sqrt and trig heavy functions, for hot loops that can take around 1e-4 of error.
+// Each one is a separate function, so call sites opt in one at a time. bench/fastMathBench.cpp measures their error
+// and speed against the precise versions.
+
+// Approximate 1 / sqrt(x), relative error below 1e-5
+// NOTE: x must be positive, rsqrt(0) is infinity
+RMAPI float FastRsqrt(float x)
+{
+#ifdef VECTOR_MATH_USE_SSE
+    // 12 bit hardware estimate, then one Newton-Raphson step
+    float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+    return y * (1.5f - 0.5f * x * y * y);
+#else
+    // Estimate from the float's bits, then two Newton-Raphson steps
+    uint32_t bits = 0;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = 0x5f375a86u - (bits >> 1);
+
+    float y = 0.0f;
+    memcpy(&y, &bits, sizeof(y));
+    y = y * (1.5f - 0.5f * x * y * y);
+    return y * (1.5f - 0.5f * x * y * y);
+#endif
+}
+
+// Wrap an angle to [-pi, pi] for the FastSin and FastCos polynomials
+// NOTE: Without branches, random angles would mispredict them
+RMAPI float FastWrapAngle(float x)
+{
+    float turns = x * (0.5f / PI);
+    return x - 2.0f * PI * (float)(int)(turns + copysignf(0.5f, turns));
+}
+
+// Minimax polynomial for sin on [-pi/2, pi/2], absolute error below 6e-7
+RMAPI float FastSinPolynomial(float x)
+{
+    float x2 = x * x;
+    return x * (0.99999662f + x2 * (-0.16664828f + x2 * (0.0083063252f + x2 * -0.00018363654f)));
+}
+
+// Approximate sine, absolute error below 1e-6 for |x| up to a few thousand radians
+RMAPI float FastSin(float x)
+{
+    // sin(x) = sign(x) * sin(|x|), and |x| folds onto [0, pi/2] with sin(|x|) = sin(pi - |x|)
+    x = FastWrapAngle(x);
+    return copysignf(FastSinPolynomial(fminf(fabsf(x), PI - fabsf(x))), x);
+}
+
+// Approximate cosine, absolute error below 1e-6 for |x| up to a few thousand radians
+RMAPI float FastCos(float x)
+{
+    // cos(x) = sin(pi/2 - |x|), already inside [-pi/2, pi/2]
+    return FastSinPolynomial(0.5f * PI - fabsf(FastWrapAngle(x)));
+}
+
+// Approximate sine and cosine of the same angle, sharing the wrap
+RMAPI void FastSinCos(float x, float* outSin, float* outCos)
+{
+    x = FastWrapAngle(x);
+    *outSin = copysignf(FastSinPolynomial(fminf(fabsf(x), PI - fabsf(x))), x);
+    *outCos = FastSinPolynomial(0.5f * PI - fabsf(x));
+}
+
+// Normalize with FastRsqrt
+RMAPI Vector3 FastNormalize(Vector3 v)
+{
+    float lengthSquared = v.x * v.x + v.y * v.y + v.z * v.z;
+    if (lengthSquared == 0.0f) return v;
+
+    float ilength = FastRsqrt(lengthSquared);
+    Vector3 result = { v.x * ilength, v.y * ilength, v.z * ilength };
+
+    return result;
+}
+
+// Normalize with FastRsqrt
+RMAPI Quaternion FastNormalize(Quaternion q)
+{
+    float lengthSquared = q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
+    if (lengthSquared == 0.0f) return q;
+
+    float ilength = FastRsqrt(lengthSquared);
+    Quaternion result = { q.x * ilength, q.y * ilength, q.z * ilength, q.w * ilength };
+
+    return result;
+}
+
+// Approximate FromAxisAngle, with FastRsqrt, FastSin and FastCos
+// NOTE: Angle must be provided in radians
+RMAPI Quaternion FastFromAxisAngle(Vector3 axis, float angle)
+{
+    Quaternion result = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+    float lengthSquared = axis.x * axis.x + axis.y * axis.y + axis.z * axis.z;
+    if (lengthSquared == 0.0f) return result;
+
+    float sinres = 0.0f;
+    float cosres = 0.0f;
+    FastSinCos(angle * 0.5f, &sinres, &cosres);
+    sinres *= FastRsqrt(lengthSquared);
+
+    result.x = axis.x * sinres;
+    result.y = axis.y * sinres;
+    result.z = axis.z * sinres;
+    result.w = cosres;
+
+    // Already unit length to within the error of FastSin and FastCos
+    return result;
+}
+
+// Approximate Rotate(v, axis, angle), with FastRsqrt, FastSin and FastCos
+RMAPI Vector3 FastRotate(Vector3 v, Vector3 axis, float angle)
+{
+    // Same Euler-Rodrigues form as Rotate
+    float lengthSquared = axis.x * axis.x + axis.y * axis.y + axis.z * axis.z;
+    if (lengthSquared == 0.0f) return v;
+
+    float a = 0.0f;
+    float cosres = 0.0f;
+    FastSinCos(angle * 0.5f, &a, &cosres);
+    a *= FastRsqrt(lengthSquared);
+    Vector3 w = { axis.x * a, axis.y * a, axis.z * a };
+    a = 2.0f * cosres;
+
+    Vector3 wv = { w.y * v.z - w.z * v.y, w.z * v.x - w.x * v.z, w.x * v.y - w.y * v.x };
+    Vector3 wwv = { w.y * wv.z - w.z * wv.y, w.z * wv.x - w.x * wv.z, w.x * wv.y - w.y * wv.x };
+
+    Vector3 result = { v.x + wv.x * a + wwv.x * 2.0f, v.y + wv.y * a + wwv.y * 2.0f, v.z + wv.z * a + wwv.z * 2.0f };
+
+    return result;
+}
+
+// Approximate Slerp, an nlerp with its amount corrected towards constant angular speed
+// NOTE: Error is around 5e-4 at worst and 5e-5 on average, with no acos or sin. Takes the shorter path like Slerp
+RMAPI Quaternion FastSlerp(Quaternion q1, Quaternion q2, float amount)
+{
+    float cosTheta = q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+    float sign = (cosTheta < 0.0f) ? -1.0f : 1.0f;
+    float d = fabsf(cosTheta);
+
+    // Nlerp moves fastest in the middle of the arc. Fitted cubic in amount that slows it there, by how far apart
+    // the quaternions are
+    float a = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+    float b = 0.848013f + d * (-1.06021f + d * 0.215638f);
+    float k = a * (amount - 0.5f) * (amount - 0.5f) + b;
+    float t = amount + amount * (amount - 0.5f) * (amount - 1.0f) * k;
+
+    float ta = 1.0f - t;
+    float tb = t * sign;
+    Quaternion result = { q1.x * ta + q2.x * tb, q1.y * ta + q2.y * tb, q1.z * ta + q2.z * tb, q1.w * ta + q2.w * tb };
+
+    return FastNormalize(result);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Batch transforms
+//----------------------------------------------------------------------------------
+
+// Transform count points stored as separate x, y and z arrays, the same as Multiply(Vector3, Matrix) on each
+// NOTE: 8 points at a time with AVX, 4 with SSE. The output arrays may be the input arrays
+RMAPI void TransformPoints(const Matrix& mat, const float* xs, const float* ys, const float* zs, size_t count, float* outX, float* outY, float* outZ)
+{
+    size_t i = 0;
+
+#ifdef VECTOR_MATH_USE_AVX
+    {
+        const __m256 m0 = _mm256_set1_ps(mat.m0), m4 = _mm256_set1_ps(mat.m4), m8 = _mm256_set1_ps(mat.m8), m12 = _mm256_set1_ps(mat.m12);
+        const __m256 m1 = _mm256_set1_ps(mat.m1), m5 = _mm256_set1_ps(mat.m5), m9 = _mm256_set1_ps(mat.m9), m13 = _mm256_set1_ps(mat.m13);
+        const __m256 m2 = _mm256_set1_ps(mat.m2), m6 = _mm256_set1_ps(mat.m6), m10 = _mm256_set1_ps(mat.m10), m14 = _mm256_set1_ps(mat.m14);
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x = _mm256_loadu_ps(xs + i);
+            __m256 y = _mm256_loadu_ps(ys + i);
+            __m256 z = _mm256_loadu_ps(zs + i);
+
+            __m256 rx = SimdMultiplyAdd(m8, z, SimdMultiplyAdd(m4, y, _mm256_mul_ps(m0, x)));
+            __m256 ry = SimdMultiplyAdd(m9, z, SimdMultiplyAdd(m5, y, _mm256_mul_ps(m1, x)));
+            __m256 rz = SimdMultiplyAdd(m10, z, SimdMultiplyAdd(m6, y, _mm256_mul_ps(m2, x)));
+
+            _mm256_storeu_ps(outX + i, _mm256_add_ps(rx, m12));
+            _mm256_storeu_ps(outY + i, _mm256_add_ps(ry, m13));
+            _mm256_storeu_ps(outZ + i, _mm256_add_ps(rz, m14));
+        }
+    }
+#endif
+
+#ifdef VECTOR_MATH_USE_SSE
+    {
+        const __m128 m0 = _mm_set1_ps(mat.m0), m4 = _mm_set1_ps(mat.m4), m8 = _mm_set1_ps(mat.m8), m12 = _mm_set1_ps(mat.m12);
+        const __m128 m1 = _mm_set1_ps(mat.m1), m5 = _mm_set1_ps(mat.m5), m9 = _mm_set1_ps(mat.m9), m13 = _mm_set1_ps(mat.m13);
+        const __m128 m2 = _mm_set1_ps(mat.m2), m6 = _mm_set1_ps(mat.m6), m10 = _mm_set1_ps(mat.m10), m14 = _mm_set1_ps(mat.m14);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(xs + i);
+            __m128 y = _mm_loadu_ps(ys + i);
+            __m128 z = _mm_loadu_ps(zs + i);
+
+            __m128 rx = SimdMultiplyAdd(m8, z, SimdMultiplyAdd(m4, y, _mm_mul_ps(m0, x)));
+            __m128 ry = SimdMultiplyAdd(m9, z, SimdMultiplyAdd(m5, y, _mm_mul_ps(m1, x)));
+            __m128 rz = SimdMultiplyAdd(m10, z, SimdMultiplyAdd(m6, y, _mm_mul_ps(m2, x)));
+
+            _mm_storeu_ps(outX + i, _mm_add_ps(rx, m12));
+            _mm_storeu_ps(outY + i, _mm_add_ps(ry, m13));
+            _mm_storeu_ps(outZ + i, _mm_add_ps(rz, m14));
+        }
+    }
+#endif
+
+    // Whatever is left over, or everything without SIMD
+    for (; i < count; i++)
+    {
+        float x = xs[i];
+        float y = ys[i];
+        float z = zs[i];
+
+        outX[i] = mat.m0 * x + mat.m4 * y + mat.m8 * z + mat.m12;
+        outY[i] = mat.m1 * x + mat.m5 * y + mat.m9 * z + mat.m13;
+        outZ[i] = mat.m2 * x + mat.m6 * y + mat.m10 * z + mat.m14;
+    }
+}
+
+// Transform an array of count points, the same as Multiply(Vector3, Matrix) on each
+// NOTE: 4 points at a time with SSE, regrouped into x, y and z registers on the way. out may be points
+RMAPI void TransformPoints(const Matrix& mat, const Vector3* points, size_t count, Vector3* out)
+{
+    size_t i = 0;
+
+#ifdef VECTOR_MATH_USE_SSE
+    const __m128 m0 = _mm_set1_ps(mat.m0), m4 = _mm_set1_ps(mat.m4), m8 = _mm_set1_ps(mat.m8), m12 = _mm_set1_ps(mat.m12);
+    const __m128 m1 = _mm_set1_ps(mat.m1), m5 = _mm_set1_ps(mat.m5), m9 = _mm_set1_ps(mat.m9), m13 = _mm_set1_ps(mat.m13);
+    const __m128 m2 = _mm_set1_ps(mat.m2), m6 = _mm_set1_ps(mat.m6), m10 = _mm_set1_ps(mat.m10), m14 = _mm_set1_ps(mat.m14);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        // Four points are twelve floats: x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+        const float* in = &points[i].x;
+        __m128 a = _mm_loadu_ps(in);
+        __m128 b = _mm_loadu_ps(in + 4);
+        __m128 c = _mm_loadu_ps(in + 8);
+
+        __m128 x2y2z2x3 = SIMD_SHUFFLE(b, c, 2, 3, 0, 1);
+        __m128 y0z0y1z1 = SIMD_SHUFFLE(a, b, 1, 2, 0, 1);
+        __m128 x2y2x3y3 = SIMD_SHUFFLE(b, c, 2, 3, 1, 2);
+
+        __m128 x = SIMD_SHUFFLE(a, x2y2z2x3, 0, 3, 0, 3);
+        __m128 y = SIMD_SHUFFLE(y0z0y1z1, x2y2x3y3, 0, 2, 1, 3);
+        __m128 z = SIMD_SHUFFLE(y0z0y1z1, c, 1, 3, 0, 3);
+
+        __m128 rx = _mm_add_ps(SimdMultiplyAdd(m8, z, SimdMultiplyAdd(m4, y, _mm_mul_ps(m0, x))), m12);
+        __m128 ry = _mm_add_ps(SimdMultiplyAdd(m9, z, SimdMultiplyAdd(m5, y, _mm_mul_ps(m1, x))), m13);
+        __m128 rz = _mm_add_ps(SimdMultiplyAdd(m10, z, SimdMultiplyAdd(m6, y, _mm_mul_ps(m2, x))), m14);
+
+        // And back to x y z order
+        __m128 x0y0x1y1 = _mm_unpacklo_ps(rx, ry);
+        __m128 x2y2x3y3Out = _mm_unpackhi_ps(rx, ry);
+        __m128 z0z0x1x1 = SIMD_SHUFFLE(rz, x0y0x1y1, 0, 0, 2, 2);
+        __m128 y1y1z1z1 = SIMD_SHUFFLE(x0y0x1y1, rz, 3, 3, 1, 1);
+        __m128 z2z2x3y3 = SIMD_SHUFFLE(rz, x2y2x3y3Out, 2, 2, 2, 3);
+        __m128 y3y3z3z3 = SIMD_SHUFFLE(x2y2x3y3Out, rz, 3, 3, 3, 3);
+
+        float* result = &out[i].x;
+        _mm_storeu_ps(result, SIMD_SHUFFLE(x0y0x1y1, z0z0x1x1, 0, 1, 0, 2));
+        _mm_storeu_ps(result + 4, SIMD_SHUFFLE(y1y1z1z1, x2y2x3y3Out, 0, 2, 0, 1));
+        _mm_storeu_ps(result + 8, SIMD_SHUFFLE(z2z2x3y3, y3y3z3z3, 0, 2, 0, 2));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        out[i] = Multiply(points[i], mat);
+    }
+}
+
+// Convert count matrices to GPU layout, ready to copy into a buffer in one go
+// NOTE: Each matrix is four loads, a 4x4 transpose and four aligned stores with SSE
+RMAPI void ToGpuMatrices(const Matrix* matrices, size_t count, GpuMatrix* out)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+#ifdef VECTOR_MATH_USE_SSE
+        __m128 rows[4];
+        SimdLoadRows(matrices[i], rows);
+        _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+
+        _mm_store_ps(out[i].v, rows[0]);
+        _mm_store_ps(out[i].v + 4, rows[1]);
+        _mm_store_ps(out[i].v + 8, rows[2]);
+        _mm_store_ps(out[i].v + 12, rows[3]);
+#else
+        out[i] = ToGpuMatrix(matrices[i]);
+#endif
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition - Culling
+//----------------------------------------------------------------------------------
+
+// Signed distance from a plane to a point, positive in front
+RMCONSTEXPR float Distance(Plane plane, Vector3 point)
+{
+    return plane.normal.x * point.x + plane.normal.y * point.y + plane.normal.z * point.z + plane.distance;
+}
+
+// Get the planes of the frustum a view-projection matrix clips to, in the space the matrix transforms from
+// NOTE: Planes are normalized, so Distance to them is a true distance and sphere radii can be compared against it
+RMAPI FrustumPlanes ToFrustumPlanes(Matrix mat)
+{
+    // Clip space x, y and z go from -w to w. Each plane is w plus or minus one of them, as functions of the input
+    // point, which are the matrix's rows (m0 m4 m8 m12), (m1 m5 m9 m13), ...
+    FrustumPlanes result = { 0 };
+
+    Vector4 x = { mat.m0, mat.m4, mat.m8, mat.m12 };
+    Vector4 y = { mat.m1, mat.m5, mat.m9, mat.m13 };
+    Vector4 z = { mat.m2, mat.m6, mat.m10, mat.m14 };
+    Vector4 w = { mat.m3, mat.m7, mat.m11, mat.m15 };
+
+    Vector4 planes[6] = { w + x, w - x, w + y, w - y, w + z, w - z };
+
+    for (int i = 0; i < 6; i++)
+    {
+        float length = sqrtf(planes[i].x * planes[i].x + planes[i].y * planes[i].y + planes[i].z * planes[i].z);
+        if (length == 0.0f) length = 1.0f;
+        float ilength = 1.0f / length;
+
+        result.planes[i].normal = { planes[i].x * ilength, planes[i].y * ilength, planes[i].z * ilength };
+        result.planes[i].distance = planes[i].w * ilength;
+    }
+
+    return result;
+}
+
+// Check if a sphere is at least partly inside the frustum
+RMCONSTEXPR int SphereInFrustum(const FrustumPlanes& frustum, Vector3 center, float radius)
+{
+    for (int i = 0; i < 6; i++)
+    {
+        if (Distance(frustum.planes[i], center) < -radius) return false;
+    }
+
+    return true;
+}
+
+// Check if an axis aligned box is at least partly inside the frustum
+// NOTE: Conservative, a box just outside a corner of the frustum can still count as inside
+RMCONSTEXPR int BoxInFrustum(const FrustumPlanes& frustum, Vector3 min, Vector3 max)
+{
+    // A box is outside a plane when its corner furthest along the normal is. Written as center and half extents,
+    // that corner's distance is Distance(center) + Dot(|normal|, extents)
+    Vector3 center = { (min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f };
+    Vector3 extents = { (max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f, (max.z - min.z) * 0.5f };
+
+    for (int i = 0; i < 6; i++)
+    {
+        const Plane& plane = frustum.planes[i];
+        float reach = fabsf(plane.normal.x) * extents.x + fabsf(plane.normal.y) * extents.y + fabsf(plane.normal.z) * extents.z;
+
+        if (Distance(plane, center) < -reach) return false;
+    }
+
+    return true;
+}
+
+// Test count spheres, stored as separate arrays, against the frustum. Bit i % 64 of outVisible[i / 64] is set if
+// sphere i is at least partly inside. Returns how many are
+// NOTE: 8 spheres at a time with AVX, 4 with SSE. outVisible needs (count + 63) / 64 words
+RMAPI size_t TestSpheres(const FrustumPlanes& frustum, const float* xs, const float* ys, const float* zs, const float* radii, size_t count, uint64_t* outVisible)
+{
+    memset(outVisible, 0, ((count + 63) / 64) * sizeof(uint64_t));
+    size_t visible = 0;
+    size_t i = 0;
+
+#ifdef VECTOR_MATH_USE_AVX
+    {
+        // Each plane's normal and distance, broadcast once instead of on every iteration
+        __m256 planes[6][4];
+        for (int p = 0; p < 6; p++)
+        {
+            planes[p][0] = _mm256_set1_ps(frustum.planes[p].normal.x);
+            planes[p][1] = _mm256_set1_ps(frustum.planes[p].normal.y);
+            planes[p][2] = _mm256_set1_ps(frustum.planes[p].normal.z);
+            planes[p][3] = _mm256_set1_ps(frustum.planes[p].distance);
+        }
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x = _mm256_loadu_ps(xs + i);
+            __m256 y = _mm256_loadu_ps(ys + i);
+            __m256 z = _mm256_loadu_ps(zs + i);
+
+            // The smallest distance to any plane decides it
+            __m256 nearest = _mm256_set1_ps(INFINITY);
+            for (int p = 0; p < 6; p++)
+            {
+                __m256 distance = SimdMultiplyAdd(planes[p][2], z, SimdMultiplyAdd(planes[p][1], y, SimdMultiplyAdd(planes[p][0], x, planes[p][3])));
+                nearest = _mm256_min_ps(nearest, distance);
+            }
+
+            __m256 radius = _mm256_loadu_ps(radii + i);
+            uint64_t mask = (uint64_t)_mm256_movemask_ps(_mm256_cmp_ps(_mm256_add_ps(nearest, radius), _mm256_setzero_ps(), _CMP_GE_OQ));
+
+            outVisible[i / 64] |= mask << (i % 64);
+            visible += SimdMaskCount(mask);
+        }
+    }
+#endif
+
+#ifdef VECTOR_MATH_USE_SSE
+    {
+        __m128 planes[6][4];
+        for (int p = 0; p < 6; p++)
+        {
+            planes[p][0] = _mm_set1_ps(frustum.planes[p].normal.x);
+            planes[p][1] = _mm_set1_ps(frustum.planes[p].normal.y);
+            planes[p][2] = _mm_set1_ps(frustum.planes[p].normal.z);
+            planes[p][3] = _mm_set1_ps(frustum.planes[p].distance);
+        }
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(xs + i);
+            __m128 y = _mm_loadu_ps(ys + i);
+            __m128 z = _mm_loadu_ps(zs + i);
+
+            __m128 nearest = _mm_set1_ps(INFINITY);
+            for (int p = 0; p < 6; p++)
+            {
+                __m128 distance = SimdMultiplyAdd(planes[p][2], z, SimdMultiplyAdd(planes[p][1], y, SimdMultiplyAdd(planes[p][0], x, planes[p][3])));
+                nearest = _mm_min_ps(nearest, distance);
+            }
+
+            __m128 radius = _mm_loadu_ps(radii + i);
+            uint64_t mask = (uint64_t)_mm_movemask_ps(_mm_cmpge_ps(_mm_add_ps(nearest, radius), _mm_setzero_ps()));
+
+            outVisible[i / 64] |= mask << (i % 64);
+            visible += SimdMaskCount(mask);
+        }
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        if (SphereInFrustum(frustum, Vector3{ xs[i], ys[i], zs[i] }, radii[i]))
+        {
+            outVisible[i / 64] |= 1ull << (i % 64);
+            visible++;
+        }
+    }
+
+    return visible;
+}
+
+// Test count axis aligned boxes, stored as separate arrays of their min and max corners, against the frustum. Fills
+// outVisible and returns how many are visible, like TestSpheres
+// NOTE: Conservative like BoxInFrustum. 8 boxes at a time with AVX, 4 with SSE
+RMAPI size_t TestBoxes(const FrustumPlanes& frustum, const float* minX, const float* minY, const float* minZ, const float* maxX, const float* maxY, const float* maxZ, size_t count, uint64_t* outVisible)
+{
+    memset(outVisible, 0, ((count + 63) / 64) * sizeof(uint64_t));
+    size_t visible = 0;
+    size_t i = 0;
+
+#ifdef VECTOR_MATH_USE_AVX
+    {
+        // Each plane's normal, its absolute value and its distance, broadcast once
+        __m256 planes[6][7];
+        for (int p = 0; p < 6; p++)
+        {
+            const Plane& plane = frustum.planes[p];
+            planes[p][0] = _mm256_set1_ps(plane.normal.x);
+            planes[p][1] = _mm256_set1_ps(plane.normal.y);
+            planes[p][2] = _mm256_set1_ps(plane.normal.z);
+            planes[p][3] = _mm256_set1_ps(plane.distance);
+            planes[p][4] = _mm256_set1_ps(fabsf(plane.normal.x));
+            planes[p][5] = _mm256_set1_ps(fabsf(plane.normal.y));
+            planes[p][6] = _mm256_set1_ps(fabsf(plane.normal.z));
+        }
+
+        const __m256 half = _mm256_set1_ps(0.5f);
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 lowX = _mm256_loadu_ps(minX + i), highX = _mm256_loadu_ps(maxX + i);
+            __m256 lowY = _mm256_loadu_ps(minY + i), highY = _mm256_loadu_ps(maxY + i);
+            __m256 lowZ = _mm256_loadu_ps(minZ + i), highZ = _mm256_loadu_ps(maxZ + i);
+
+            __m256 centerX = _mm256_mul_ps(_mm256_add_ps(lowX, highX), half), extentX = _mm256_mul_ps(_mm256_sub_ps(highX, lowX), half);
+            __m256 centerY = _mm256_mul_ps(_mm256_add_ps(lowY, highY), half), extentY = _mm256_mul_ps(_mm256_sub_ps(highY, lowY), half);
+            __m256 centerZ = _mm256_mul_ps(_mm256_add_ps(lowZ, highZ), half), extentZ = _mm256_mul_ps(_mm256_sub_ps(highZ, lowZ), half);
+
+            // Distance to the furthest corner along each plane's normal, the smallest over all planes decides it
+            __m256 nearest = _mm256_set1_ps(INFINITY);
+            for (int p = 0; p < 6; p++)
+            {
+                __m256 distance = SimdMultiplyAdd(planes[p][2], centerZ, SimdMultiplyAdd(planes[p][1], centerY, SimdMultiplyAdd(planes[p][0], centerX, planes[p][3])));
+                __m256 reach = SimdMultiplyAdd(planes[p][6], extentZ, SimdMultiplyAdd(planes[p][5], extentY, _mm256_mul_ps(planes[p][4], extentX)));
+                nearest = _mm256_min_ps(nearest, _mm256_add_ps(distance, reach));
+            }
+
+            uint64_t mask = (uint64_t)_mm256_movemask_ps(_mm256_cmp_ps(nearest, _mm256_setzero_ps(), _CMP_GE_OQ));
+
+            outVisible[i / 64] |= mask << (i % 64);
+            visible += SimdMaskCount(mask);
+        }
+    }
+#endif
+
+#ifdef VECTOR_MATH_USE_SSE
+    {
+        __m128 planes[6][7];
+        for (int p = 0; p < 6; p++)
+        {
+            const Plane& plane = frustum.planes[p];
+            planes[p][0] = _mm_set1_ps(plane.normal.x);
+            planes[p][1] = _mm_set1_ps(plane.normal.y);
+            planes[p][2] = _mm_set1_ps(plane.normal.z);
+            planes[p][3] = _mm_set1_ps(plane.distance);
+            planes[p][4] = _mm_set1_ps(fabsf(plane.normal.x));
+            planes[p][5] = _mm_set1_ps(fabsf(plane.normal.y));
+            planes[p][6] = _mm_set1_ps(fabsf(plane.normal.z));
+        }
+
+        const __m128 half = _mm_set1_ps(0.5f);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 lowX = _mm_loadu_ps(minX + i), highX = _mm_loadu_ps(maxX + i);
+            __m128 lowY = _mm_loadu_ps(minY + i), highY = _mm_loadu_ps(maxY + i);
+            __m128 lowZ = _mm_loadu_ps(minZ + i), highZ = _mm_loadu_ps(maxZ + i);
+
+            __m128 centerX = _mm_mul_ps(_mm_add_ps(lowX, highX), half), extentX = _mm_mul_ps(_mm_sub_ps(highX, lowX), half);
+            __m128 centerY = _mm_mul_ps(_mm_add_ps(lowY, highY), half), extentY = _mm_mul_ps(_mm_sub_ps(highY, lowY), half);
+            __m128 centerZ = _mm_mul_ps(_mm_add_ps(lowZ, highZ), half), extentZ = _mm_mul_ps(_mm_sub_ps(highZ, lowZ), half);
+
+            __m128 nearest = _mm_set1_ps(INFINITY);
+            for (int p = 0; p < 6; p++)
+            {
+                __m128 distance = SimdMultiplyAdd(planes[p][2], centerZ, SimdMultiplyAdd(planes[p][1], centerY, SimdMultiplyAdd(planes[p][0], centerX, planes[p][3])));
+                __m128 reach = SimdMultiplyAdd(planes[p][6], extentZ, SimdMultiplyAdd(planes[p][5], extentY, _mm_mul_ps(planes[p][4], extentX)));
+                nearest = _mm_min_ps(nearest, _mm_add_ps(distance, reach));
+            }
+
+            uint64_t mask = (uint64_t)_mm_movemask_ps(_mm_cmpge_ps(nearest, _mm_setzero_ps()));
+
+            outVisible[i / 64] |= mask << (i % 64);
+            visible += SimdMaskCount(mask);
+        }
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        if (BoxInFrustum(frustum, Vector3{ minX[i], minY[i], minZ[i] }, Vector3{ maxX[i], maxY[i], maxZ[i] }))
+        {
+            outVisible[i / 64] |= 1ull << (i % 64);
+            visible++;
+        }
+    }
+
+    return visible;
+}
+
 //----------------------------------------------------------------------------------
 // Module Functions Definition - Vector & Matrix helpers
 //----------------------------------------------------------------------------------
 
-RMAPI Vector3 Forward(Matrix m)
+RMCONSTEXPR Vector3 Forward(Matrix m)
 {
     return { m.m8, m.m9, m.m10 };
 }
 
-RMAPI Vector3 Right(Matrix m)
+RMCONSTEXPR Vector3 Right(Matrix m)
 {
     return { m.m0, m.m1, m.m2 };
 }
 
-RMAPI Vector3 Up(Matrix m)
+RMCONSTEXPR Vector3 Up(Matrix m)
 {
     return { m.m4, m.m5, m.m6 };
 }
 
-RMAPI Vector3 Translation(Matrix m)
+RMCONSTEXPR Vector3 Translation(Matrix m)
 {
     return { m.m12, m.m13, m.m14 };
 }
 
-RMAPI Matrix Translate(Vector3 v)
+RMCONSTEXPR Matrix Translate(Vector3 v)
 {
     return Translate(v.x, v.y, v.z);
 }
@@ -2294,7 +3282,7 @@ RMAPI Quaternion FromEuler(Vector3 v)
     return FromEuler(v.x, v.y, v.z);
 }
 
-RMAPI Matrix Scale(Vector3 v)
+RMCONSTEXPR Matrix Scale(Vector3 v)
 {
     return Scale(v.x, v.y, v.z);
 }
@@ -2303,92 +3291,92 @@ RMAPI Matrix Scale(Vector3 v)
 // Module Functions Definition - Global operator overloads
 //----------------------------------------------------------------------------------
 
-RMAPI Vector2 operator+(Vector2 a, Vector2 b)
+RMCONSTEXPR Vector2 operator+(Vector2 a, Vector2 b)
 {
     return Add(a, b);
 }
 
-RMAPI Vector2 operator-(Vector2 a, Vector2 b)
+RMCONSTEXPR Vector2 operator-(Vector2 a, Vector2 b)
 {
     return Subtract(a, b);
 }
 
-RMAPI Vector2 operator*(Vector2 a, Vector2 b)
+RMCONSTEXPR Vector2 operator*(Vector2 a, Vector2 b)
 {
     return Multiply(a, b);
 }
 
-RMAPI Vector2 operator/(Vector2 a, Vector2 b)
+RMCONSTEXPR Vector2 operator/(Vector2 a, Vector2 b)
 {
     return Divide(a, b);
 }
 
-RMAPI Vector2 operator+(Vector2 a, float b)
+RMCONSTEXPR Vector2 operator+(Vector2 a, float b)
 {
     return Add(a, b);
 }
 
-RMAPI Vector2 operator-(Vector2 a, float b)
+RMCONSTEXPR Vector2 operator-(Vector2 a, float b)
 {
     return Subtract(a, b);
 }
 
-RMAPI Vector2 operator*(Vector2 a, float b)
+RMCONSTEXPR Vector2 operator*(Vector2 a, float b)
 {
     return Scale(a, b);
 }
 
-RMAPI Vector2 operator/(Vector2 a, float b)
+RMCONSTEXPR Vector2 operator/(Vector2 a, float b)
 {
     return Scale(a, 1.0f / b);
 }
 
-RMAPI Vector3 operator+(Vector3 a, Vector3 b)
+RMCONSTEXPR Vector3 operator+(Vector3 a, Vector3 b)
 {
     return Add(a, b);
 }
 
-RMAPI Vector3 operator-(Vector3 a, Vector3 b)
+RMCONSTEXPR Vector3 operator-(Vector3 a, Vector3 b)
 {
     return Subtract(a, b);
 }
 
-RMAPI Vector3 operator*(Vector3 a, Vector3 b)
+RMCONSTEXPR Vector3 operator*(Vector3 a, Vector3 b)
 {
     return Multiply(a, b);
 }
 
-RMAPI Vector3 operator/(Vector3 a, Vector3 b)
+RMCONSTEXPR Vector3 operator/(Vector3 a, Vector3 b)
 {
     return Divide(a, b);
 }
 
-RMAPI Vector3 operator+(Vector3 a, float b)
+RMCONSTEXPR Vector3 operator+(Vector3 a, float b)
 {
     return Add(a, b);
 }
 
-RMAPI Vector3 operator-(Vector3 a, float b)
+RMCONSTEXPR Vector3 operator-(Vector3 a, float b)
 {
     return Subtract(a, b);
 }
 
-RMAPI Vector3 operator*(Vector3 a, float b)
+RMCONSTEXPR Vector3 operator*(Vector3 a, float b)
 {
     return Scale(a, b);
 }
 
-RMAPI Vector3 operator/(Vector3 a, float b)
+RMCONSTEXPR Vector3 operator/(Vector3 a, float b)
 {
     return Scale(a, 1.0f / b);
 }
 
-RMAPI Vector4 operator+(Vector4 a,  Vector4 b)
+RMCONSTEXPR Vector4 operator+(Vector4 a,  Vector4 b)
 {
     return Add(a, b);
 }
 
-RMAPI Vector4 operator-(Vector4 a,  Vector4 b)
+RMCONSTEXPR Vector4 operator-(Vector4 a,  Vector4 b)
 {
     return Subtract(a, b);
 }
@@ -2398,37 +3386,37 @@ RMAPI Vector4 operator*(Vector4 a,  Vector4 b)
     return Multiply(a, b);
 }
 
-RMAPI Vector4 operator/(Vector4 a,  Vector4 b)
+RMCONSTEXPR Vector4 operator/(Vector4 a,  Vector4 b)
 {
     return Divide(a, b);
 }
 
-RMAPI Vector4 operator+(Vector4 a, float b)
+RMCONSTEXPR Vector4 operator+(Vector4 a, float b)
 {
     return Add(a, b);
 }
 
-RMAPI Vector4 operator-(Vector4 a, float b)
+RMCONSTEXPR Vector4 operator-(Vector4 a, float b)
 {
     return Subtract(a, b);
 }
 
-RMAPI Vector4 operator*(Vector4 a, float b)
+RMCONSTEXPR Vector4 operator*(Vector4 a, float b)
 {
     return Scale(a, b);
 }
 
-RMAPI Vector4 operator/(Vector4 a, float b)
+RMCONSTEXPR Vector4 operator/(Vector4 a, float b)
 {
     return Scale(a, 1.0f / b);
 }
 
-RMAPI Matrix operator+(Matrix a, Matrix b)
+RMCONSTEXPR Matrix operator+(Matrix a, Matrix b)
 {
     return Add(a, b);
 }
 
-RMAPI Matrix operator-(Matrix a, Matrix b)
+RMCONSTEXPR Matrix operator-(Matrix a, Matrix b)
 {
     return Subtract(a, b);
 }
@@ -2447,22 +3435,27 @@ RMAPI Vector4 operator*(Matrix m, Vector4 v)
     return Multiply(v, m);
 }
 
-RMAPI Vector3 operator*(Matrix m, Vector3 v)
+RMCONSTEXPR Vector3 operator*(Matrix m, Vector3 v)
 {
     return Multiply(v, m);
 }
 
-RMAPI Vector2 operator*(Matrix m, Vector2 v)
+RMCONSTEXPR Vector2 operator*(Matrix m, Vector2 v)
 {
     return Multiply(v, m);
 }
 
-RMAPI Vector3 operator*(Quaternion a, Vector3 b)
+RMCONSTEXPR Vector3 operator*(Quaternion a, Vector3 b)
 {
     // Not part of raylib but uses ToMatrix which is part of raylib
     return Multiply(b, ToMatrix(a));
 }
 
+RMAPI TRS operator*(TRS a, TRS b)
+{
+    return Multiply(a, b);
+}
+
 //----------------------------------------------------------------------------------
 // Module Functions Definition - Member operator overloads
 //----------------------------------------------------------------------------------
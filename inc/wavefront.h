@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "vectorMath.h"
+
+class JobSystem;
+
+// A face corner with no texture coordinate or normal, like the 1//3 or 1 forms.
+#define WAVEFRONT_MISSING_INDEX 0xFFFFFFFFu
+
+// Parallel parsing cuts the file into about this many chunks per thread, but none smaller than the minimum, so small
+// files are parsed on the calling thread alone.
+#define WAVEFRONT_CHUNKS_PER_THREAD 4
+#define WAVEFRONT_MIN_CHUNK_BYTES (256 * 1024)
+
+
+struct WavefrontData {
+    /* Everything CreateStaticMeshFromWavefront needs from an .obj file, before anything is sent to the GPU.
+
+    Faces are split into triangles. Each triangle corner has three zero based indices, one into each attribute list,
+    at the same place in PositionIndices, TextureCoordIndices and NormalIndices. Corners without a texture
+    coordinate or normal use WAVEFRONT_MISSING_INDEX there. */
+
+    std::string Name = "None";
+
+    std::vector<Vector3> Positions;
+    std::vector<Vector2> TextureCoords;
+    std::vector<Vector3> Normals;
+
+    std::vector<uint32_t> PositionIndices;
+    std::vector<uint32_t> TextureCoordIndices;
+    std::vector<uint32_t> NormalIndices;
+
+    // Corners per usemtl surface, in file order. Always at least one surface, even if the file never sets a material.
+    std::vector<uint32_t> SurfaceIndexCounts;
+
+    void Clear();
+};
+
+
+// Parse .obj text in place. Prints the line and returns false if the text is malformed. With a JobSystem, large
+// texts are parsed on all of its threads.
+bool ParseWavefront(const char* text, size_t size, WavefrontData& outData, JobSystem* jobs = nullptr);
+
+// Map an .obj file and parse it.
+bool LoadWavefront(const char* path, WavefrontData& outData, JobSystem* jobs = nullptr);
+
+// Give every distinct (position, texture coordinate, normal) corner of data its own vertex, and index the corners
+// into them in the same order as PositionIndices. Missing normals point up and missing texture coordinates are 0.
+void BuildWavefrontVertices(const WavefrontData& data, std::vector<Vertex>& outVertices, std::vector<uint32_t>& outIndices);
@@ -0,0 +1,112 @@
+#include <iostream>
+
+#include "asset.h"
+
+
+void* GetAsset(AssetHandle handle) {
+    AssetPool* pool = FindAssetPool(GetAssetType(handle));
+    return (pool == nullptr) ? nullptr : pool->Get(handle);
+}
+
+static void UnlinkFromParent(void* gameObject) {
+    /* Remove an asset from its parent's list of children. */
+
+    void* parent = GetAsset(GET_ASSET_PARENT(gameObject));
+
+    if (parent == nullptr) {
+        GET_ASSET_PARENT(gameObject) = INVALID_ASSET_HANDLE;
+        GET_ASSET_NEXT_SIBLING(gameObject) = INVALID_ASSET_HANDLE;
+        return;
+    }
+
+    const AssetHandle handle = GET_ASSET_HANDLE(gameObject);
+    AssetHandle* link = &GET_ASSET_FIRST_CHILD(parent);
+
+    // Find whichever handle points at this asset, the parent's first child or a sibling's next, and skip over it.
+    while (*link != INVALID_ASSET_HANDLE) {
+
+        if (*link == handle) {
+            *link = GET_ASSET_NEXT_SIBLING(gameObject);
+            break;
+        }
+
+        void* sibling = GetAsset(*link);
+        if (sibling == nullptr) {
+            break;
+        }
+        link = &GET_ASSET_NEXT_SIBLING(sibling);
+    }
+
+    GET_ASSET_PARENT(gameObject) = INVALID_ASSET_HANDLE;
+    GET_ASSET_NEXT_SIBLING(gameObject) = INVALID_ASSET_HANDLE;
+}
+
+bool SetParent(AssetHandle child, AssetHandle parent) {
+
+    void* childObject = GetAsset(child);
+    void* parentObject = (parent == INVALID_ASSET_HANDLE) ? nullptr : GetAsset(parent);
+
+    if (childObject == nullptr || (parent != INVALID_ASSET_HANDLE && parentObject == nullptr)) {
+        std::cout << "SetParent: Asset handle is stale or invalid." << std::endl;
+        return false;
+    }
+
+    // Refuse to make a cycle.
+    for (AssetHandle ancestor = parent; ancestor != INVALID_ASSET_HANDLE;) {
+        if (ancestor == child) {
+            std::cout << "SetParent: Tried to parent an asset to its own child." << std::endl;
+            return false;
+        }
+
+        void* ancestorObject = GetAsset(ancestor);
+        if (ancestorObject == nullptr) {
+            break;
+        }
+        ancestor = GET_ASSET_PARENT(ancestorObject);
+    }
+
+    UnlinkFromParent(childObject);
+
+    if (parentObject != nullptr) {
+        GET_ASSET_PARENT(childObject) = parent;
+        GET_ASSET_NEXT_SIBLING(childObject) = GET_ASSET_FIRST_CHILD(parentObject);
+        GET_ASSET_FIRST_CHILD(parentObject) = child;
+    }
+
+    GetTransformStore().SetParent(GET_ASSET_TRANSFORM_HANDLE(childObject), (parentObject == nullptr) ? INVALID_TRANSFORM : GET_ASSET_TRANSFORM_HANDLE(parentObject));
+    return true;
+}
+
+bool DestroyAsset(AssetHandle handle) {
+    /* Destroy an asset of any type. Its children become roots. */
+
+    void* gameObject = GetAsset(handle);
+
+    if (gameObject == nullptr) {
+        std::cout << "DestroyAsset: Asset handle is stale or invalid." << std::endl;
+        return false;
+    }
+
+    UnlinkFromParent(gameObject);
+
+    AssetHandle childHandle = GET_ASSET_FIRST_CHILD(gameObject);
+    while (childHandle != INVALID_ASSET_HANDLE) {
+        void* child = GetAsset(childHandle);
+        if (child == nullptr) {
+            break;
+        }
+
+        childHandle = GET_ASSET_NEXT_SIBLING(child);
+        GET_ASSET_PARENT(child) = INVALID_ASSET_HANDLE;
+        GET_ASSET_NEXT_SIBLING(child) = INVALID_ASSET_HANDLE;
+    }
+    GET_ASSET_FIRST_CHILD(gameObject) = INVALID_ASSET_HANDLE;
+
+    // Deleting the transform, in the asset's destructor, makes the children's transforms roots as well.
+    return FindAssetPool(GetAssetType(handle))->Free(handle);
+}
+
+Matrix GetGlobalTransform(AssetHandle handle) {
+    void* gameObject = GetAsset(handle);
+    return (gameObject == nullptr) ? MatrixIdentity() : GetGlobalTransform(gameObject);
+}
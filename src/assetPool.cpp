@@ -0,0 +1,154 @@
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include "assetPool.h"
+
+// Every pool adds itself here when it's created, so assets can be found from a handle alone.
+static AssetPool* RegisteredPools[ASSET_POOL_TYPES] = { nullptr };
+
+static const PoolStats* RegisteredStats[ASSET_POOL_TYPES] = { nullptr };
+
+AssetPool* FindAssetPool(uint8_t type) {
+    return (type < ASSET_POOL_TYPES) ? RegisteredPools[type] : nullptr;
+}
+
+void RegisterPoolStats(uint8_t type, const PoolStats* stats) {
+    assert(type < ASSET_POOL_TYPES);
+    RegisteredStats[type] = stats;
+}
+
+const PoolStats* GetPoolStats(uint8_t type) {
+    return (type < ASSET_POOL_TYPES) ? RegisteredStats[type] : nullptr;
+}
+
+
+AssetPool::AssetPool(uint8_t type, uint32_t elementSize, DestructorFunction destructor) : Type(type), ElementSize(elementSize) {
+    assert(type != 0 && type < ASSET_POOL_TYPES);
+    assert(RegisteredPools[type] == nullptr);
+
+    Data = nullptr;
+    AssetCount = 0;
+    Capacity = 0;
+    Destructor = destructor;
+    FreeHead = ASSET_HANDLE_MAX_INDEX;
+
+    Stats.Type = type;
+    Stats.ElementSize = elementSize;
+
+    RegisteredPools[type] = this;
+    RegisterPoolStats(type, &Stats);
+}
+
+AssetPool::~AssetPool() {
+    /* Pools are destroyed at exit, after the GL context is gone, so the assets left in them are not destructed.
+    Destroy assets that own GL objects before then. */
+
+    RegisteredPools[Type] = nullptr;
+    RegisterPoolStats(Type, nullptr);
+    FreeAligned(Data);
+    Data = nullptr;
+}
+
+void AssetPool::Grow() {
+    const uint32_t capacity = (Capacity == 0) ? 16 : Capacity * 2;
+
+    // Assets are relocatable, so they can be copied into the new block. Nothing changes if it can't be allocated.
+    uint8_t* data = static_cast<uint8_t*>(AllocateAligned(static_cast<uint64_t>(capacity) * ElementSize, POOL_CACHE_LINE));
+    if (data == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    if (Data != nullptr) {
+        memcpy(data, Data, static_cast<uint64_t>(AssetCount) * ElementSize);
+        FreeAligned(Data);
+    }
+    Data = data;
+    Capacity = capacity;
+
+    Stats.Capacity = Capacity;
+    Stats.BytesReserved = static_cast<uint64_t>(Capacity) * ElementSize;
+}
+
+void* AssetPool::Allocate(AssetHandle& outHandle) {
+
+    // Grow before taking a slot, so a failed allocation leaves the pool as it was.
+    if (AssetCount == Capacity) {
+        Grow();
+    }
+
+    uint32_t slot;
+
+    // Reuse a free slot if there is one. Its generation was already bumped when it was freed.
+    if (FreeHead != ASSET_HANDLE_MAX_INDEX) {
+        slot = FreeHead;
+        FreeHead = Sparse[slot];
+    }
+    else {
+        if (Sparse.size() >= ASSET_HANDLE_MAX_INDEX) {
+            std::cout << "AssetPool: Out of handles for asset type " << (int)Type << "." << std::endl;
+            outHandle = INVALID_ASSET_HANDLE;
+            return nullptr;
+        }
+
+        slot = static_cast<uint32_t>(Sparse.size());
+        Sparse.push_back(0);
+        Generations.push_back(0);
+    }
+
+    Sparse[slot] = AssetCount;
+    DenseToSlot.push_back(slot);
+    outHandle = MAKE_ASSET_HANDLE(Type, Generations[slot], slot);
+    Stats.CountAllocation();
+
+    return GetDense(AssetCount++);
+}
+
+bool AssetPool::Free(AssetHandle handle) {
+
+    if (!IsValid(handle)) {
+        return false;
+    }
+
+    const uint32_t slot = ASSET_HANDLE_INDEX(handle);
+    const uint32_t index = Sparse[slot];
+    const uint32_t last = AssetCount - 1;
+
+    Destructor(GetDense(index));
+
+    // Move the last asset into the gap and point its handle at the new spot.
+    if (index != last) {
+        memcpy(GetDense(index), GetDense(last), ElementSize);
+        DenseToSlot[index] = DenseToSlot[last];
+        Sparse[DenseToSlot[index]] = index;
+    }
+
+    DenseToSlot.pop_back();
+    AssetCount--;
+
+    // Bumping the generation makes every existing handle to this slot stale.
+    Generations[slot]++;
+    Sparse[slot] = FreeHead;
+    FreeHead = slot;
+    Stats.CountFree();
+
+    return true;
+}
+
+bool AssetPool::IsValid(AssetHandle handle) const {
+    const uint32_t slot = ASSET_HANDLE_INDEX(handle);
+
+    return ASSET_HANDLE_TYPE(handle) == Type && slot < Sparse.size() && Generations[slot] == ASSET_HANDLE_GENERATION(handle)
+        && Sparse[slot] < AssetCount && DenseToSlot[Sparse[slot]] == slot;
+}
+
+void* AssetPool::Get(AssetHandle handle) const {
+    return IsValid(handle) ? GetDense(Sparse[ASSET_HANDLE_INDEX(handle)]) : nullptr;
+}
+
+AssetHandle AssetPool::GetDenseHandle(uint32_t index) const {
+    const uint32_t slot = DenseToSlot[index];
+    return MAKE_ASSET_HANDLE(Type, Generations[slot], slot);
+}
@@ -39,7 +39,7 @@ Camera::~Camera() {}
 
 void DefaultCameraInit(Camera* camera) {
     SetCaptureCursor(true);
-    camera->Transform = MatrixIdentity();
+    SET_ASSET_TRANSFORM(camera, TRSIdentity());
     camera->ViewMatrix = MatrixIdentity();
     camera->Rotation = QuaternionIdentity();
 }
@@ -90,10 +90,12 @@ void NoClipCameraUpdate(Camera* camera, const double deltaTime, const double rat
     desiredMovement *= (camera->MoveSpeed * (float)DeltaTime());
     desiredMovement = Rotate(desiredMovement, camera->Rotation);
 
-    // Apply the movement matrix and rotation matrix to the camera's transform.
-    camera->Transform = camera->Transform * Translate(desiredMovement.x, desiredMovement.y, desiredMovement.z);
+    // Move the camera's position directly, rather than multiplying its matrix by a translation every frame.
+    TRS transform = GetTransformStore().GetLocal(GET_ASSET_TRANSFORM_HANDLE(camera));
+    transform.translation += desiredMovement;
+    SET_ASSET_TRANSFORM(camera, transform);
 
     // Recalculate the view matrix from the updated camera transform and rotation.
     Matrix rotationMatrix = ToMatrix(Invert(camera->Rotation));
-    camera->ViewMatrix =  camera->Transform * rotationMatrix * Perspective(DEG2RAD * camera->Fov, ratio, camera->NearClip, camera->FarClip);
+    camera->ViewMatrix =  ToMatrix(transform) * rotationMatrix * Perspective(DEG2RAD * camera->Fov, ratio, camera->NearClip, camera->FarClip);
 }
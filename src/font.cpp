@@ -5,6 +5,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
+#include <new>
 #include <fstream>
 #include <sstream>
 #include <cstring>
@@ -17,6 +18,7 @@
 #include "mesh.h"
 #include "font.h"
 #include "renderable.h"
+#include "slabPool.h"
 
 // Generate stb_trueType body here since it's only needed here.
 #define STB_TRUETYPE_IMPLEMENTATION
@@ -27,6 +29,19 @@ static HashTable<Font> FontTable(64);
 #define DEFAULT_START_CHARACTER 31
 
 
+void* Font::operator new(size_t size) {
+	assert(size == sizeof(Font));
+	void* memory = GetSlabPool<Font>(ObjectType::Font).Allocate();
+	if (memory == nullptr) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void Font::operator delete(void* font) {
+	GetSlabPool<Font>(ObjectType::Font).Free(font);
+}
+
 Font::Font(Material* material, uint16_t charactersToLoad, uint16_t atlasSize) : material(material), CharactersLoaded(charactersToLoad), AtlasSize(atlasSize) {
     textureAtlas = new Texture();
     textureAtlas->width = AtlasSize;
@@ -45,9 +60,11 @@ Font::~Font() {
     delete[] fontAtlasTextureData;
     delete[] packedChars;
     delete[] alignedQuads;
+    delete[] alias;
     fontAtlasTextureData = nullptr;
     packedChars = nullptr;
     alignedQuads = nullptr;
+    alias = nullptr;
 }
 
 
@@ -105,8 +122,11 @@ Font* CreateFont(const char* path, const char* alias, Material* material, const
     
     Font* font = nullptr;
 
+    // Hash the alias once, the font table and texture table both use it.
+    StringId aliasId(alias);
+
     // try to find the font in the table.
-    FontTable.Find(alias, font);
+    FontTable.Find(aliasId, font);
 
     // if the font doesn't already exist, make a new one, and return that instead.
     if (font != nullptr) {
@@ -114,7 +134,7 @@ Font* CreateFont(const char* path, const char* alias, Material* material, const
     }
 
     font = FontManager::InternalLoadFont(path, material, pointSize);
-    TextureManager::InternalCreateTexture(font->textureAtlas, false, alias, GL_RED, GL_RED, font->fontAtlasTextureData, false);
+    TextureManager::InternalCreateTexture(font->textureAtlas, false, aliasId, GL_RED, GL_RED, font->fontAtlasTextureData, false);
     SetTextureFromPointer(material, font->textureAtlas, 0);
 
     if (font == nullptr) {
@@ -122,8 +142,9 @@ Font* CreateFont(const char* path, const char* alias, Material* material, const
         return nullptr;
     }
 
-    // Reference the key in font struct for faster insertions.
-    font->alias = FontTable.Insert(alias, font);
+    // The table's copy of the key moves when the table resizes, so the font keeps its own.
+    font->alias = CopyString(aliasId);
+    FontTable.Insert(aliasId, font, true);
 
     return font;
 
@@ -155,11 +176,14 @@ void DeleteFont(const char* alias) {
 void DereferenceFonts() {
     /* Call this function at the end of your program to ensure all tracked textures are properly cleaned up. */
 
+    // Make sure every font is in the current array before walking over it.
+    FontTable.FinishMigration();
+
     // Iterate through all the positions in the hash table.
     for (uint64_t i = 0; i < FontTable.Size; i++) {
 
         // Check if there is a value stored here:
-        if (FontTable.Array[i].Key == nullptr) {
+        if (!FontTable.SlotUsed(i)) {
             continue;
         }
 
@@ -204,7 +228,10 @@ void DrawTextMesh(const TextRender* textRender, const Camera* camera, const doub
     }
 
     // Calculate the projection. in this case its just an Orthographic projection to show up in screen-space.
-    Matrix mvp = MatrixIdentity() * Ortho(-aspectRatio, aspectRatio, -1.0, 1.0, 1.0, -1.0);
+    // Only the x scale depends on the aspect ratio, the rest of the matrix is built at compile time.
+    static constexpr Matrix screenSpace = Ortho(-1.0, 1.0, -1.0, 1.0, 1.0, -1.0);
+    Matrix mvp = screenSpace;
+    mvp.m0 /= aspectRatio;
     DrawRenderable(textRender->textMesh, textRender->font->material, &mvp, time);
 
 }
@@ -345,6 +372,10 @@ void SetText(TextRender* textRender, const char* string, int x, int y, const flo
 
 
 void SetFont(TextRender* textRender, const char* fontName, Font* defaultFont) {
+    SetFont(textRender, StringId(fontName), defaultFont);
+}
+
+void SetFont(TextRender* textRender, const StringId& fontName, Font* defaultFont) {
     /* Set the font for a text render from the alias of the font. */
 
     if (textRender->font != nullptr) {
@@ -362,7 +393,7 @@ void SetFont(TextRender* textRender, const char* fontName, Font* defaultFont) {
         return;
     }
 
-    std::cout << "Error setting TextRender font: Font by name \"" << fontName << "\" could not be found, ";
+    std::cout << "Error setting TextRender font: Font by name \"" << fontName.String << "\" could not be found, ";
 
     if (defaultFont != nullptr) {
         std::cout << "using default Font, \"" << defaultFont->alias << "\"." << std::endl;
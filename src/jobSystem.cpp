@@ -0,0 +1,106 @@
+#include "jobSystem.h"
+
+
+JobSystem::JobSystem(uint32_t threadCount) {
+
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+
+    Function = nullptr;
+    Context = nullptr;
+    Begin = 0;
+    End = 0;
+    BatchSize = 1;
+    BatchCount = 0;
+    NextBatch.store(0);
+    Generation = 0;
+    Busy = 0;
+    Quit = false;
+
+    // The calling thread does work too, so it counts as one of the threads.
+    for (uint32_t i = 1; i < threadCount; i++) {
+        Workers.emplace_back(&JobSystem::WorkerLoop, this);
+    }
+}
+
+JobSystem::~JobSystem() {
+
+    {
+        std::lock_guard<std::mutex> lock(Lock);
+        Quit = true;
+    }
+    WakeWorkers.notify_all();
+
+    for (std::thread& worker : Workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::Run(uint32_t begin, uint32_t end, uint32_t batchSize, const void* context, JobFunction function) {
+
+    {
+        // A worker that woke up late for the last job may still be looking at it, so wait for it before replacing it.
+        std::unique_lock<std::mutex> lock(Lock);
+        WorkersDone.wait(lock, [this] { return Busy == 0; });
+
+        Function = function;
+        Context = context;
+        Begin = begin;
+        End = end;
+        BatchSize = batchSize;
+        BatchCount = (end - begin + batchSize - 1) / batchSize;
+        NextBatch.store(0, std::memory_order_relaxed);
+        Generation++;
+    }
+    WakeWorkers.notify_all();
+
+    RunBatches();
+
+    // Every batch has been taken, but workers may still be running theirs.
+    std::unique_lock<std::mutex> lock(Lock);
+    WorkersDone.wait(lock, [this] { return Busy == 0; });
+}
+
+void JobSystem::RunBatches() {
+
+    for (;;) {
+        const uint32_t batch = NextBatch.fetch_add(1, std::memory_order_relaxed);
+
+        if (batch >= BatchCount) {
+            return;
+        }
+
+        const uint32_t first = Begin + batch * BatchSize;
+        const uint32_t last = (End - first > BatchSize) ? first + BatchSize : End;
+        Function(Context, first, last);
+    }
+}
+
+void JobSystem::WorkerLoop() {
+
+    uint64_t seen = 0;
+
+    for (;;) {
+
+        {
+            std::unique_lock<std::mutex> lock(Lock);
+            WakeWorkers.wait(lock, [this, seen] { return Quit || Generation != seen; });
+
+            if (Quit) {
+                return;
+            }
+
+            seen = Generation;
+            Busy++;
+        }
+
+        RunBatches();
+
+        {
+            std::lock_guard<std::mutex> lock(Lock);
+            Busy--;
+        }
+        WorkersDone.notify_all();
+    }
+}
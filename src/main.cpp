@@ -9,6 +9,8 @@
 #include <array>
 
 #include "glUtilities.h"
+#include "hashTable.h"
+#include "jobSystem.h"
 #include "vectorMath.h"
 #include "texture.h"
 #include "material.h"
@@ -41,23 +43,28 @@ int main(void) {
     Material* Mat0 = new Material("./assets/shaders/default.vert", "./assets/shaders/ditheredAlpha.frag", 1, GL_BACK, GL_LESS);
     
     // Set Material Textures:
-    SetTextureFromAlias(Mat0, "MissingTexture", 0);
+    SetTextureFromAlias(Mat0, STRING_ID("MissingTexture"), 0);
     
     // Load Font:
     Font* departureMono = CreateFont("./assets/defaultAssets/DepartureMono-Regular.ttf", "DepartureMono", DefaultTextMaterial, 14.0f);
     
     // There is a known issue with fonts right now. Something is getting deleted when it isn't supposed to. Will run fine on a first pass.  
-    TextRender* testText = new TextRender();
-    SetFont(testText, "DepartureMono", departureMono);
+    TextRender* testText = CreateAsset<TextRender>();
+    SetFont(testText, STRING_ID("DepartureMono"), departureMono);
+    AssetHandle testTextHandle = testText->Handle;
 
 
     StaticMesh* mesh = CreateStaticMeshPrimativePlane(1, 1);
     mesh->SetMaterial(Mat0, 0);
-    Matrix* transform = GET_ASSET_TRANSFORM(mesh);
+    AssetHandle meshHandle = mesh->Handle;
     
-    *transform = *transform * Translate(0.0f, 0.0f, -1.0f);
+    GetTransformStore().SetPosition(GET_ASSET_TRANSFORM_HANDLE(mesh), Vector3{ 0.0f, 0.0f, -1.0f });
 
-    Camera* mainCamera = new Camera(NoClipCameraUpdate);
+    Camera* mainCamera = CreateAsset<Camera>(NoClipCameraUpdate);
+    AssetHandle mainCameraHandle = mainCamera->Handle;
+
+    // Worker threads for per-frame work, one per core.
+    JobSystem jobs;
 
     int x = 0;
     int y = 0;
@@ -84,9 +91,17 @@ int main(void) {
             x--;
         }
 
+        // Asset pointers can move when other assets are created or destroyed, so look them up from their handles.
+        mainCamera = GetAsset<Camera>(mainCameraHandle);
+        testText = GetAsset<TextRender>(testTextHandle);
+
         mainCamera->Update(mainCamera, DeltaTime(), AspectRatio());
+
+        // Recompute the world matrices of everything that moved this frame.
+        GetTransformStore().UpdateTransforms(jobs);
      
-        mesh->Draw(mainCamera, (GLfloat)Time());
+        // Every mesh sits in one pool, so this walks them in memory order.
+        ForEachAsset<StaticMesh>([&](StaticMesh* staticMesh) { staticMesh->Draw(mainCamera, (GLfloat)Time()); });
        
         SetText(testText,"This is a test.", x, y, static_cast<float>(WindowWidth()), static_cast<float>(WindowHeight()), 1.0f);
         DrawTextMesh(testText, mainCamera, AspectRatio(), (GLfloat)Time());
@@ -100,16 +115,16 @@ int main(void) {
         
     }
 
-    delete mainCamera;
+    DestroyAsset(mainCameraHandle);
 
-    delete mesh;
+    DestroyAsset(meshHandle);
 
     delete DefaultTextMaterial;
     delete NormalMaterial;
     delete TChoodColorMaterial;
     delete Mat0;
 
-    delete testText;
+    DestroyAsset(testTextHandle);
 
     glUtilTerminate();
     return 0;
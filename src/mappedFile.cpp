@@ -0,0 +1,156 @@
+#include <iostream>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "mappedFile.h"
+
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::Open(const char* path) {
+    Close();
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cout << "MappedFile: Could not open " << path << "." << std::endl;
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        std::cout << "MappedFile: Could not get the size of " << path << "." << std::endl;
+        CloseHandle(file);
+        return false;
+    }
+
+    FileHandle = file;
+    ViewSize = static_cast<size_t>(size.QuadPart);
+
+    // Windows can't map an empty file.
+    if (ViewSize == 0) {
+        return true;
+    }
+
+    MappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    View = (MappingHandle == nullptr) ? nullptr : static_cast<const char*>(MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0));
+
+    if (View == nullptr) {
+        std::cout << "MappedFile: Could not map " << path << "." << std::endl;
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void MappedFile::Close() {
+    if (View != nullptr) {
+        UnmapViewOfFile(View);
+    }
+    if (MappingHandle != nullptr) {
+        CloseHandle(MappingHandle);
+    }
+    if (FileHandle != nullptr) {
+        CloseHandle(FileHandle);
+    }
+
+    View = nullptr;
+    ViewSize = 0;
+    MappingHandle = nullptr;
+    FileHandle = nullptr;
+}
+
+bool GetFileInfo(const char* path, uint64_t& outSize, int64_t& outModifiedTime) {
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExA(path, GetFileExInfoStandard, &attributes)) {
+        return false;
+    }
+
+    outSize = (static_cast<uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+
+    // The raw FILETIME, in 100 nanosecond intervals since 1601. Scaling it to nanoseconds would overflow an int64_t.
+    outModifiedTime = static_cast<int64_t>((static_cast<uint64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32) | attributes.ftLastWriteTime.dwLowDateTime);
+    return true;
+}
+
+#else
+
+bool MappedFile::Open(const char* path) {
+    Close();
+
+    const int file = open(path, O_RDONLY);
+    if (file < 0) {
+        std::cout << "MappedFile: Could not open " << path << "." << std::endl;
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0) {
+        std::cout << "MappedFile: Could not get the size of " << path << "." << std::endl;
+        close(file);
+        return false;
+    }
+
+    // mmap can't map an empty file.
+    if (status.st_size == 0) {
+        close(file);
+        return true;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+    // The mapping keeps the file alive on its own.
+    close(file);
+
+    if (view == MAP_FAILED) {
+        std::cout << "MappedFile: Could not map " << path << "." << std::endl;
+        return false;
+    }
+
+    // The whole file is read front to back, so ask for it to be read ahead.
+    madvise(view, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+
+    View = static_cast<const char*>(view);
+    ViewSize = static_cast<size_t>(status.st_size);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (View != nullptr) {
+        munmap(const_cast<char*>(View), ViewSize);
+    }
+
+    View = nullptr;
+    ViewSize = 0;
+}
+
+bool GetFileInfo(const char* path, uint64_t& outSize, int64_t& outModifiedTime) {
+    struct stat status;
+    if (stat(path, &status) != 0) {
+        return false;
+    }
+
+    outSize = static_cast<uint64_t>(status.st_size);
+
+#if defined(__APPLE__)
+    outModifiedTime = static_cast<int64_t>(status.st_mtimespec.tv_sec) * 1000000000 + status.st_mtimespec.tv_nsec;
+#else
+    outModifiedTime = static_cast<int64_t>(status.st_mtim.tv_sec) * 1000000000 + status.st_mtim.tv_nsec;
+#endif
+    return true;
+}
+
+#endif
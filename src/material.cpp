@@ -5,14 +5,30 @@
 #include <cassert>
 #include <cstring>
 #include <iostream>
+#include <new>
 #include <vector>
 
 #include "createShader.h"
 #include "hashTable.h"
+#include "asset.h"
 #include "material.h"
+#include "slabPool.h"
 #include "texture.h"
 
 
+void* Material::operator new(size_t size) {
+    assert(size == sizeof(Material));
+    void* memory = GetSlabPool<Material>(ObjectType::Material).Allocate();
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void Material::operator delete(void* material) {
+    GetSlabPool<Material>(ObjectType::Material).Free(material);
+}
+
 Material::Material(const char* vertexProgramPath, const char* fragmentProgramPath, const uint16_t numberOfTextures, const GLenum cullFuncton, const GLenum depthFunction) {
     TexturesUsed = numberOfTextures;
     CullFunction = cullFuncton;
@@ -151,6 +167,10 @@ void SetTextureFromPointer(const Material* material, Texture* texture, uint16_t
 }
 
 void SetTextureFromAlias(const Material* material, const char* alias, uint16_t index) {
+    SetTextureFromAlias(material, StringId(alias), index);
+}
+
+void SetTextureFromAlias(const Material* material, const StringId& alias, uint16_t index) {
     /* Set a material's texture at the given index, by the texture's alias. */
 
     if (material == nullptr) {
@@ -167,7 +187,7 @@ void SetTextureFromAlias(const Material* material, const char* alias, uint16_t i
     TextureManager::FindTexture(alias, texture);
 
     if (texture == nullptr) {
-        std::cout << "Error setting Material Texture: \"" << alias << "\" At index: " << index << ". The texture could not be found." << std::endl;
+        std::cout << "Error setting Material Texture: \"" << alias.String << "\" At index: " << index << ". The texture could not be found." << std::endl;
         return;
     }
 
@@ -4,30 +4,28 @@
 #include <cstdlib>
 #include <cassert>
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <cstring>
+#include <string>
 #include <vector>
 
 #include "camera.h"
 #include "mesh.h"
 #include "material.h"
+#include "mappedFile.h"
+#include "meshCache.h"
 #include "renderable.h"
 #include "par_shapes.h"
-
-const uint16_t LINE_BUFFER_SIZE = 512;
-const uint16_t MAX_ITERATIONS = 0xffff;
-
+#include "wavefront.h"
 
 StaticMesh::StaticMesh(uint16_t materialCount) : MaterialCount(materialCount) {
     meshRenders = new Mesh[materialCount];
     materials = new Material*[materialCount];
-    Transform = MatrixIdentity();
 }
 
-StaticMesh::StaticMesh(uint16_t materialCount, Matrix transform) : MaterialCount(materialCount), Transform(transform) {
+StaticMesh::StaticMesh(uint16_t materialCount, Matrix transform) : MaterialCount(materialCount) {
     meshRenders = new Mesh[materialCount];
     materials = new Material*[materialCount];
+    SET_ASSET_TRANSFORM(this, ToTRS(transform));
 }
 
 StaticMesh::~StaticMesh() {
@@ -67,7 +65,8 @@ void StaticMesh::Draw(Camera* camera, GLfloat time) const {
         return;
     }
 
-    Matrix mvp = Transform * camera->ViewMatrix;
+    // World matrices are cached by the transform store, see UpdateTransforms.
+    Matrix mvp = *GetTransformStore().GetWorldMatrix(GET_ASSET_TRANSFORM_HANDLE(this)) * camera->ViewMatrix;
 
     // run a draw call for each material.
     for (uint16_t i = 0; i < MaterialCount; i++) {
@@ -75,232 +74,120 @@ void StaticMesh::Draw(Camera* camera, GLfloat time) const {
     }
 }
 
-Vector2 Vector2FromString(const std::string data) {
-
-	std::stringstream dataStream(data);
-	std::string segment;
-	std::vector<std::string> segmentList;
+template<typename Index> static void UploadSurfaces(StaticMesh* mesh, const Index* indices, const Vertex* vertices, const size_t vertexCount, const uint32_t* surfaceIndexCounts, const size_t surfaceCount) {
+    /* Upload the first surface with the interleaved vertex buffer. Every other surface is a sub-mesh referencing
+    the buffers from the first mesh, drawing its own run of indices. */
 
-	while(std::getline(dataStream, segment, ' ')) {
-        if (!segment.empty()) {
-            segmentList.push_back(segment);
-        }
-	}
+    UploadInterleavedMesh(&mesh->meshRenders[0], indices, vertices, surfaceIndexCounts[0], vertexCount);
 
-    Vector2 vector{0.0f, 0.0f};
+    size_t surfaceStart = 0;
 
-	vector.x = std::stof(segmentList[0]);
-	vector.y = std::stof(segmentList[1]);
-
-	return vector;
-	
+    for (size_t i = 1; i < surfaceCount; i++) {
+        surfaceStart += surfaceIndexCounts[i - 1];
+        UploadSubMesh(&mesh->meshRenders[i], &mesh->meshRenders[0], &indices[surfaceStart], surfaceIndexCounts[i]);
+    }
 }
 
-Vector3 Vector3FromString(const std::string data) {
+static StaticMesh* CreateStaticMeshFromVertices(const char* path, const std::string& name, const Vertex* vertices, const size_t vertexCount,
+    const void* indices, const uint32_t indexSize, const uint32_t* surfaceIndexCounts, const size_t surfaceCount) {
+    /* Make a mesh with one material per surface from an interleaved vertex buffer and 2 or 4 byte indices. */
 
-	std::stringstream dataStream(data);
-	std::string segment;
-	std::vector<std::string> segmentList;
+    if (surfaceCount > 0xFFFF) {
+        std::cout << "Wavefront (" << path << ") has too many materials." << std::endl;
+        return nullptr;
+    }
 
-	while(std::getline(dataStream, segment, ' ')) {
-        if (!segment.empty()) {
-   		    segmentList.push_back(segment);
-        }
-	}
+    StaticMesh* newMesh = CreateAsset<StaticMesh>(static_cast<uint16_t>(surfaceCount), MatrixIdentity());
 
-    Vector3 vector{0.0f, 0.0f, 0.0f};
+    // The pool has already printed why.
+    if (newMesh == nullptr) {
+        return nullptr;
+    }
 
-	vector.x = std::stof(segmentList[0]);
-	vector.y = std::stof(segmentList[1]);
-	vector.z = std::stof(segmentList[2]);
+    SetAlias(newMesh, name.c_str());
 
-	return vector;
+    if (indexSize == sizeof(uint16_t)) {
+        UploadSurfaces(newMesh, static_cast<const uint16_t*>(indices), vertices, vertexCount, surfaceIndexCounts, surfaceCount);
+    }
+    else {
+        UploadSurfaces(newMesh, static_cast<const uint32_t*>(indices), vertices, vertexCount, surfaceIndexCounts, surfaceCount);
+    }
+
+    return newMesh;
 }
 
-void parseFace(std::vector<uint16_t>* vi, std::vector<uint16_t>* ti, std::vector<uint16_t>* ni, std::vector<std::string> segmentList) {
-    
-    // For each of the three points in the face,
-    for (int i = 0; i < segmentList.size(); i++) {
-        std::stringstream subDataStream(segmentList[i]);
-        std::string subSegment;
-        std::vector<std::string> subSegmentList;
-
-        while (std::getline(subDataStream, subSegment, '/')) {
-            subSegmentList.push_back(subSegment);
-        }
-
-        // for each subset, get the int stored there.
-        // This kind of sucks but it means that if there's a missing index nothing is added for that list.
-        // TODO: add support for models that lack UV or Normal data.
-        for (int k = 0; k < subSegmentList.size(); k++) {
-            switch (k) {
-            case 0:	vi->push_back(std::stoi(subSegmentList[0]) - 1); break;
-            case 1:	ti->push_back(std::stoi(subSegmentList[1]) - 1); break;
-            case 2:	ni->push_back(std::stoi(subSegmentList[2]) - 1); break;
-            default: break;
-            }
-        }
+static void UploadParShapesMesh(Mesh* mesh, const par_shapes_mesh* parMesh, const Vector2* tCoordArray) {
+    /* par_shapes is built with 32 bit indices, narrow them when every point fits in 16 bits. */
+
+    const size_t indexCount = static_cast<size_t>(parMesh->ntriangles) * 3;
+
+    if (static_cast<size_t>(parMesh->npoints) <= MESH_MAX_SHORT_INDEX_VERTICES) {
+        std::vector<uint16_t> indices(parMesh->triangles, parMesh->triangles + indexCount);
+        UploadMesh(mesh, indices.data(), (Vector3*)parMesh->points, (Vector3*)parMesh->normals, tCoordArray, indexCount, parMesh->npoints);
+    }
+    else {
+        UploadMesh(mesh, parMesh->triangles, (Vector3*)parMesh->points, (Vector3*)parMesh->normals, tCoordArray, indexCount, parMesh->npoints);
     }
 }
 
-int parseFaceIndicies(std::vector<uint16_t>* vi, std::vector<uint16_t>* ti, std::vector<uint16_t>* ni, const std::string data) {
-	/* This function parses an incoming wavefront file face data and added the indicies to the corresponding lists. 
-	Faces are stored as f n/n/n n/n/n n/n/n where the subsets are the indicies of the vertex, texture coordinate, and normal. */
+StaticMesh* CreateStaticMeshFromWavefront(const char* path, JobSystem* jobs) {
+    /* Parse an obj file and load a mesh from it. Large files are parsed on the threads of jobs, if given.
 
-	std::stringstream dataStream(data);
-	std::string segment;
-	std::vector<std::string> segmentList;
+    The first load bakes the result into a .dmesh cache next to the file. Later loads map the cache and hand its
+    buffers straight to GL, until the obj file changes. */ 
 
-	while(std::getline(dataStream, segment, ' ')) {
-   		segmentList.push_back(segment);
-	}
+    // Verify that the file extension is obj.
+    const char* ext = strrchr(path, '.');
+    assert(ext != nullptr && (strcmp(ext, ".obj") == 0 || strcmp(ext, ".OBJ") == 0));
+
+    const std::string cachePath = MeshCachePath(path);
+    MeshCacheData cache;
 
-    if (segmentList.size() == 3) {
-        parseFace(vi, ti, ni, segmentList);
-        return 3;
+    if (LoadMeshCache(cachePath.c_str(), path, cache)) {
+        return CreateStaticMeshFromVertices(path, cache.Name, cache.Vertices, cache.VertexCount, cache.Indices, cache.IndexSize, cache.SurfaceIndexCounts, cache.SurfaceCount);
     }
 
-    if (segmentList.size() == 4) {
-        std::vector<std::string> firstTriangle { segmentList[0], segmentList[1], segmentList[2] };
-        std::vector<std::string> secondTriangle{ segmentList[2], segmentList[3], segmentList[0] };
+    MeshCacheSource source;
+    MappedFile file;
 
-        parseFace(vi, ti, ni, firstTriangle);
-        parseFace(vi, ti, ni, secondTriangle);
+    if (!GetFileInfo(path, source.Size, source.ModifiedTime) || !file.Open(path)) {
+        std::cout << "Wavefront (" << path << ") not found." << std::endl;
+        return nullptr;
     }
-    return 6;
-}
 
-StaticMesh* CreateStaticMeshFromWavefront(const char* path) {
-    /* Parse an obj file and load a mesh from it. */ 
-    
-    // Interpret the file as a giant string
-    std::stringstream stream;
-
-    try {
-        std::ifstream file;
-	    file.exceptions(std::ifstream::failbit | std::ifstream::badbit);    // Set exceptions for try catch.
-        file.open(path);                                                    // Attempt to open the file.
-        stream << file.rdbuf();
-        file.close();
-    }
-    catch (std::ifstream::failure& e) {
-        std::cout << "Wavefront (" << path << ") not found: " << e.what() << std::endl;
+    source.Hash = HashMeshSource(file.Data(), file.Size());
+
+    WavefrontData data;
+
+    if (!ParseWavefront(file.Data(), file.Size(), data, jobs)) {
         return nullptr;
     }
 
-    // Verify that the file extension is obj.
-    const char* ext = strrchr(path, '.');
-    assert(strcmp(ext, ".obj") == 0 || strcmp(ext, ".OBJ") == 0);
-
-    char lineBuffer[LINE_BUFFER_SIZE];
-    char identifyer[2] = { '\0', '\0' };
-    uint16_t lineCount = 0;
-    uint16_t materialCount = 0;
-
-    std::string ObjectName = "None";
-    std::vector<uint16_t> surfaceSplitIndecies;
-	std::vector<uint16_t> vi; 
-	std::vector<uint16_t> ti; 
-	std::vector<uint16_t> ni; 
-	
-	std::vector<Vector3> vertexList;
-	std::vector<Vector3> normalList;
-	std::vector<Vector2> tCoordList;
-
-    stream.seekp(0);
-    uint16_t iteration = 0;
-    uint16_t indiciesParced = 0;
-	
-    while (!stream.eof() || ++iteration < MAX_ITERATIONS) {
-    
-    	// Copy the line into the buffer:
-    	stream.getline(lineBuffer, LINE_BUFFER_SIZE);       // Get the current line from the file.
-    	memcpy(identifyer, lineBuffer, 2 * sizeof(char));   // Copy the first two characters from the line buffer.
-		
-		// Quick hack to get it as a string.
-		std::string lineBufferString = std::string(lineBuffer);
-
-    	switch (identifyer[0]) {
-    	case '#':   // comment line, skip this one.
-            break;
-
-        case 'o':   // object name.
-            ObjectName = lineBufferString.substr(2);
-            break;
-
-        case 's':   // use smooth shading or not.
-                  
-            break;
-
-        case 'u':   // material.
-            
-            if (identifyer[1] != 's') {
-                break;
-            }
-
-            materialCount++;
-            surfaceSplitIndecies.push_back(indiciesParced);
-            indiciesParced = 0;
-            break;
-
-    	case 'f':
-    	    //handle face stuff here.
-            indiciesParced += parseFaceIndicies(&vi, &ti, &ni, lineBufferString.substr(2));
-            break;
-
-        // handle all vertex cases.
-    	case 'v':
-    	    switch (identifyer[1]) {
-    	    case ' ':   // vertex
-                vertexList.push_back(Vector3FromString(lineBufferString.substr(2)));
-				break;
-    	    case 't':   // tCoord
-                tCoordList.push_back(Vector2FromString(lineBufferString.substr(3)));
-				break;
-    	    case 'n':   // normal
-                normalList.push_back(Vector3FromString(lineBufferString.substr(3)));
-                break;
-    	    }
-        default:
-            break;
-        }
-	}
-    
-    if (surfaceSplitIndecies.empty()) {
-        surfaceSplitIndecies.push_back(indiciesParced);
-    }
-    else {
-        surfaceSplitIndecies[0] = indiciesParced;
+    if (data.PositionIndices.empty()) {
+        std::cout << "Wavefront (" << path << ") has no faces." << std::endl;
+        return nullptr;
     }
 
-    // Create a new mesh from the index data which follows the standards of OpenGL.
-
-    // Assert that all index list are the same size.
-    assert(vi.size() == ni.size() && ni.size() == ti.size());
+    // One vertex per distinct corner, so corners that share a position but not a normal or UV keep their own.
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    BuildWavefrontVertices(data, vertices, indices);
 
-    std::vector<Vector3> normalArray(vi.size(), Vector3{ 0.0f, 1.0f, 0.0f });
-    std::vector<Vector2> tCoordArray(vi.size(), Vector2{ 0.0f, 0.0f });
+    // Half the index bandwidth when every vertex fits in 16 bits.
+    std::vector<uint16_t> shortIndices;
+    const bool useShortIndices = vertices.size() <= MESH_MAX_SHORT_INDEX_VERTICES;
 
-    for (uint16_t i = 0; i < vi.size(); i++) {
-        normalArray[vi[i]] = normalList[ni[i]];
-        tCoordArray[vi[i]] = tCoordList[ti[i]];
+    if (useShortIndices) {
+        shortIndices.assign(indices.begin(), indices.end());
     }
 
-    StaticMesh* newMesh = new StaticMesh((materialCount == 0) ? 1 : materialCount, MatrixIdentity());
-    SetAlias(newMesh, ObjectName.c_str());
+    const void* indexData = useShortIndices ? static_cast<const void*>(shortIndices.data()) : static_cast<const void*>(indices.data());
+    const uint32_t indexSize = useShortIndices ? sizeof(uint16_t) : sizeof(uint32_t);
 
-    // upload the first mesh containing the actual vertex, normal and tChoord buffers. 
-    UploadMesh(&(newMesh->meshRenders[0]), &vi[0], &vertexList[0], &normalArray[0], &tCoordArray[0], surfaceSplitIndecies[0], vertexList.size());
-    
-    //starting at the first material split, upload a sub-mesh referencing the buffers from the first mesh.
-    uint16_t currentMaterialElementIndex = 0;
+    // A cache that can't be written only costs the next load a parse.
+    WriteMeshCache(cachePath.c_str(), source, data.Name, vertices.data(), vertices.size(), indexData, indexSize, indices.size(), data.SurfaceIndexCounts.data(), data.SurfaceIndexCounts.size());
 
-    for (uint16_t i = 1; i < materialCount; i++) {
-        // Copy the vbo, tbo, and nbo from the first mesh which holds all the data.
-        currentMaterialElementIndex += surfaceSplitIndecies[i];
-        UploadSubMesh(&newMesh->meshRenders[i], &newMesh->meshRenders[0], &vi[currentMaterialElementIndex], surfaceSplitIndecies[i]);
-    }
-	return newMesh;
+    return CreateStaticMeshFromVertices(path, data.Name, vertices.data(), vertices.size(), indexData, indexSize, data.SurfaceIndexCounts.data(), data.SurfaceIndexCounts.size());
 }
 
 //par_shapes_mesh* tmp = parMesh;
@@ -310,7 +197,7 @@ StaticMesh* CreateStaticMeshFromWavefront(const char* path) {
 
 
 StaticMesh* CreateStaticMeshFromRawData(const uint16_t* indeciesArray, const  Vector3* vertexBufferArray, const  Vector3* normalBufferArray, const  Vector2* tCoordArray, const  size_t indecies, const  size_t vertecies) {
-    StaticMesh* newMesh = new StaticMesh(1, MatrixIdentity());
+    StaticMesh* newMesh = CreateAsset<StaticMesh>(1, MatrixIdentity());
     UploadMesh(&(newMesh->meshRenders[0]), indeciesArray, vertexBufferArray, normalBufferArray, tCoordArray, indecies, vertecies);
     return newMesh;
 }
@@ -318,8 +205,8 @@ StaticMesh* CreateStaticMeshFromRawData(const uint16_t* indeciesArray, const  Ve
 
 StaticMesh* CreateStaticMeshPrimativeCone(int slices, int stacks) {
     par_shapes_mesh* parMesh = par_shapes_create_cone(slices, stacks);
-    StaticMesh* newMesh = new StaticMesh(1, MatrixIdentity());
-    UploadMesh(&(newMesh->meshRenders[0]), parMesh->triangles, (Vector3*)parMesh->points, (Vector3*)parMesh->normals, (Vector2*)parMesh->tcoords, parMesh->ntriangles * 3, parMesh->npoints);
+    StaticMesh* newMesh = CreateAsset<StaticMesh>(1, MatrixIdentity());
+    UploadParShapesMesh(&(newMesh->meshRenders[0]), parMesh, (Vector2*)parMesh->tcoords);
     par_shapes_free_mesh(parMesh);
     return newMesh;
 }
@@ -327,8 +214,8 @@ StaticMesh* CreateStaticMeshPrimativeCone(int slices, int stacks) {
 
 StaticMesh* CreateStaticMeshPrimativeCylinder(int slices, int stacks) {
     par_shapes_mesh* parMesh = par_shapes_create_cylinder(slices, stacks);
-    StaticMesh* newMesh = new StaticMesh(1, MatrixIdentity());
-    UploadMesh(&(newMesh->meshRenders[0]), parMesh->triangles, (Vector3*)parMesh->points, (Vector3*)parMesh->normals, (Vector2*)parMesh->tcoords, parMesh->ntriangles * 3, parMesh->npoints);
+    StaticMesh* newMesh = CreateAsset<StaticMesh>(1, MatrixIdentity());
+    UploadParShapesMesh(&(newMesh->meshRenders[0]), parMesh, (Vector2*)parMesh->tcoords);
     par_shapes_free_mesh(parMesh);
     return newMesh;
 }
@@ -336,8 +223,8 @@ StaticMesh* CreateStaticMeshPrimativeCylinder(int slices, int stacks) {
 
 StaticMesh* CreateStaticMeshPrimativeTorus(int slices, int stacks, float radius) {
     par_shapes_mesh* parMesh = par_shapes_create_torus(slices, stacks, radius);
-    StaticMesh* newMesh = new StaticMesh(1, MatrixIdentity());
-    UploadMesh(&(newMesh->meshRenders[0]), parMesh->triangles, (Vector3*)parMesh->points, (Vector3*)parMesh->normals, (Vector2*)parMesh->tcoords, parMesh->ntriangles * 3, parMesh->npoints);
+    StaticMesh* newMesh = CreateAsset<StaticMesh>(1, MatrixIdentity());
+    UploadParShapesMesh(&(newMesh->meshRenders[0]), parMesh, (Vector2*)parMesh->tcoords);
     par_shapes_free_mesh(parMesh);
     return newMesh;
 }
@@ -345,8 +232,8 @@ StaticMesh* CreateStaticMeshPrimativeTorus(int slices, int stacks, float radius)
 
 StaticMesh* CreateStaticMeshPrimativePlane(int slices, int stacks) {
     par_shapes_mesh* parMesh = par_shapes_create_plane(slices, stacks);
-    StaticMesh* newMesh = new StaticMesh(1, MatrixIdentity());
-    UploadMesh(&(newMesh->meshRenders[0]), parMesh->triangles, (Vector3*)parMesh->points, (Vector3*)parMesh->normals, (Vector2*)parMesh->tcoords, parMesh->ntriangles * 3, parMesh->npoints);
+    StaticMesh* newMesh = CreateAsset<StaticMesh>(1, MatrixIdentity());
+    UploadParShapesMesh(&(newMesh->meshRenders[0]), parMesh, (Vector2*)parMesh->tcoords);
     par_shapes_free_mesh(parMesh);
     return newMesh;
 }
@@ -354,9 +241,9 @@ StaticMesh* CreateStaticMeshPrimativePlane(int slices, int stacks) {
 
 StaticMesh* CreateStaticMeshPrimativeSphere(int subdivisions) {
     par_shapes_mesh* parMesh = par_shapes_create_subdivided_sphere(subdivisions);
-    StaticMesh* newMesh = new StaticMesh(1, MatrixIdentity());
+    StaticMesh* newMesh = CreateAsset<StaticMesh>(1, MatrixIdentity());
     Vector2* tCoord = new Vector2[parMesh->npoints]{ {0.0f, 0.0f} };
-    UploadMesh(&(newMesh->meshRenders[0]), parMesh->triangles, (Vector3*)parMesh->points, (Vector3*)parMesh->normals, tCoord, parMesh->ntriangles * 3, parMesh->npoints);
+    UploadParShapesMesh(&(newMesh->meshRenders[0]), parMesh, tCoord);
     par_shapes_free_mesh(parMesh);
     delete[] tCoord;
     return newMesh;
@@ -0,0 +1,300 @@
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "hashTable.h"
+#include "meshCache.h"
+
+// A .dmesh file is a MeshCacheHeader followed by its sections, each starting on a MESH_CACHE_ALIGNMENT boundary:
+// the interleaved vertices, the indices, the indices per surface (uint32_t) and the name. Integers and floats are
+// written in the machine's byte order, since a cache is only ever read back where it was baked.
+
+struct MeshCacheAttribute {
+    /* Where one vertex attribute is in a Vertex: its shader location, float count and byte offset. */
+
+    uint32_t Location;
+    uint32_t Components;
+    uint32_t Offset;
+};
+
+struct MeshCacheHeader {
+    uint32_t Magic;
+    uint32_t Version;
+
+    uint64_t SourceSize;
+    int64_t SourceModifiedTime;
+    uint64_t SourceHash;
+
+    // Vertex layout. A cache with a layout other than the current Vertex is rebuilt.
+    uint32_t VertexStride;
+    uint32_t AttributeCount;
+    MeshCacheAttribute Attributes[3];
+
+    uint32_t IndexSize;
+    uint32_t SurfaceCount;
+    uint64_t VertexCount;
+    uint64_t IndexCount;
+
+    Vector3 BoundsMin;
+    Vector3 BoundsMax;
+
+    uint32_t NameLength;
+    uint64_t VertexOffset;
+    uint64_t IndexOffset;
+    uint64_t SurfaceOffset;
+    uint64_t NameOffset;
+};
+
+static const MeshCacheAttribute VertexLayout[3] = {
+    { 0, 3, static_cast<uint32_t>(offsetof(Vertex, position)) },
+    { 1, 3, static_cast<uint32_t>(offsetof(Vertex, normal)) },
+    { 2, 2, static_cast<uint32_t>(offsetof(Vertex, textureCoord)) },
+};
+
+
+static uint64_t AlignOffset(uint64_t offset) {
+    return (offset + MESH_CACHE_ALIGNMENT - 1) & ~static_cast<uint64_t>(MESH_CACHE_ALIGNMENT - 1);
+}
+
+static void Append(std::vector<uint8_t>& out, const void* data, const uint64_t size) {
+    /* Append size bytes to out, padded to the next section boundary. */
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytes, bytes + size);
+    out.resize(AlignOffset(out.size()), 0);
+}
+
+std::string MeshCachePath(const char* sourcePath) {
+
+    std::string path(sourcePath);
+    const size_t extension = path.find_last_of("./\\");
+
+    if (extension != std::string::npos && path[extension] == '.') {
+        path.resize(extension);
+    }
+
+    return path + MESH_CACHE_EXTENSION;
+}
+
+uint64_t HashMeshSource(const char* data, size_t size) {
+    return HashKey(data, data + size);
+}
+
+bool WriteMeshCache(const char* path, const MeshCacheSource& source, const std::string& name, const Vertex* vertices, size_t vertexCount,
+    const void* indices, uint32_t indexSize, size_t indexCount, const uint32_t* surfaceIndexCounts, size_t surfaceCount) {
+
+    MeshCacheHeader header;
+    memset(&header, 0, sizeof(header));
+
+    header.Magic = MESH_CACHE_MAGIC;
+    header.Version = MESH_CACHE_VERSION;
+    header.SourceSize = source.Size;
+    header.SourceModifiedTime = source.ModifiedTime;
+    header.SourceHash = source.Hash;
+
+    header.VertexStride = sizeof(Vertex);
+    header.AttributeCount = 3;
+    memcpy(header.Attributes, VertexLayout, sizeof(VertexLayout));
+
+    header.IndexSize = indexSize;
+    header.SurfaceCount = static_cast<uint32_t>(surfaceCount);
+    header.VertexCount = vertexCount;
+    header.IndexCount = indexCount;
+
+    header.BoundsMin = (vertexCount == 0) ? Vector3{ 0.0f, 0.0f, 0.0f } : vertices[0].position;
+    header.BoundsMax = header.BoundsMin;
+    for (size_t i = 1; i < vertexCount; i++) {
+        header.BoundsMin = Min(header.BoundsMin, vertices[i].position);
+        header.BoundsMax = Max(header.BoundsMax, vertices[i].position);
+    }
+
+    header.NameLength = static_cast<uint32_t>(name.size());
+    header.VertexOffset = AlignOffset(sizeof(MeshCacheHeader));
+    header.IndexOffset = AlignOffset(header.VertexOffset + vertexCount * sizeof(Vertex));
+    header.SurfaceOffset = AlignOffset(header.IndexOffset + indexCount * indexSize);
+    header.NameOffset = AlignOffset(header.SurfaceOffset + surfaceCount * sizeof(uint32_t));
+
+    std::vector<uint8_t> out;
+    out.reserve(header.NameOffset + name.size() + MESH_CACHE_ALIGNMENT);
+
+    Append(out, &header, sizeof(header));
+    Append(out, vertices, vertexCount * sizeof(Vertex));
+    Append(out, indices, indexCount * indexSize);
+    Append(out, surfaceIndexCounts, surfaceCount * sizeof(uint32_t));
+    Append(out, name.data(), name.size());
+
+    const std::string temporaryPath = std::string(path) + ".tmp";
+
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+
+        if (!file) {
+            std::cout << "MeshCache: Could not write " << temporaryPath << "." << std::endl;
+            file.close();
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+
+    // rename won't replace an existing file on Windows.
+    std::remove(path);
+
+    if (std::rename(temporaryPath.c_str(), path) != 0) {
+        std::cout << "MeshCache: Could not move " << temporaryPath << " to " << path << "." << std::endl;
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+enum class SourceState {
+    Current,        // Same size and write time as when the cache was baked.
+    Touched,        // Same contents, but a newer write time. The cache is fine, its header just needs the new time.
+    Changed,
+};
+
+static SourceState CheckSource(const MeshCacheHeader& header, const char* sourcePath, int64_t& outModifiedTime) {
+    /* Compare the cache against its source, only hashing the source if the write time alone differs. */
+
+    uint64_t size = 0;
+    outModifiedTime = header.SourceModifiedTime;
+
+    if (!GetFileInfo(sourcePath, size, outModifiedTime)) {
+        return SourceState::Current;
+    }
+
+    if (size != header.SourceSize) {
+        return SourceState::Changed;
+    }
+
+    if (outModifiedTime == header.SourceModifiedTime) {
+        return SourceState::Current;
+    }
+
+    MappedFile source;
+    const bool sameHash = source.Open(sourcePath) && HashMeshSource(source.Data(), source.Size()) == header.SourceHash;
+    return sameHash ? SourceState::Touched : SourceState::Changed;
+}
+
+static void UpdateSourceModifiedTime(const char* path, int64_t modifiedTime) {
+    /* Write a new source write time into a cache's header, so the next load doesn't hash the source again. If it
+    can't be written the cache still works, it just costs a hash per load. */
+
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(offsetof(MeshCacheHeader, SourceModifiedTime));
+    file.write(reinterpret_cast<const char*>(&modifiedTime), sizeof(modifiedTime));
+}
+
+template<typename Index> static bool IndicesInRange(const Index* indices, uint64_t count, uint64_t vertexCount) {
+    Index largest = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        largest = (indices[i] > largest) ? indices[i] : largest;
+    }
+    return count == 0 || largest < vertexCount;
+}
+
+static bool SectionFits(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t fileSize) {
+    /* Whether count elements starting at offset are inside the file. Divides instead of multiplying, so a damaged
+    count can't overflow. */
+    return offset % MESH_CACHE_ALIGNMENT == 0 && offset <= fileSize && count <= (fileSize - offset) / elementSize;
+}
+
+bool LoadMeshCache(const char* path, const char* sourcePath, MeshCacheData& outData) {
+
+    outData.File.Close();
+
+    uint64_t cacheSize = 0;
+    int64_t cacheModifiedTime = 0;
+
+    // No cache yet is the normal first run, not an error.
+    if (!GetFileInfo(path, cacheSize, cacheModifiedTime) || !outData.File.Open(path)) {
+        return false;
+    }
+
+    const uint64_t fileSize = outData.File.Size();
+    MeshCacheHeader header;
+
+    if (fileSize < sizeof(header)) {
+        std::cout << "MeshCache: " << path << " is too small to be a mesh." << std::endl;
+        outData.File.Close();
+        return false;
+    }
+    memcpy(&header, outData.File.Data(), sizeof(header));
+
+    // An older version or a different vertex layout is out of date rather than damaged.
+    const bool sameLayout = header.VertexStride == sizeof(Vertex) && header.AttributeCount == 3 && memcmp(header.Attributes, VertexLayout, sizeof(VertexLayout)) == 0;
+
+    if (header.Magic != MESH_CACHE_MAGIC || header.Version != MESH_CACHE_VERSION || !sameLayout) {
+        outData.File.Close();
+        return false;
+    }
+
+    int64_t sourceModifiedTime = 0;
+    const SourceState sourceState = CheckSource(header, sourcePath, sourceModifiedTime);
+
+    if (sourceState == SourceState::Changed) {
+        outData.File.Close();
+        return false;
+    }
+
+    // Windows won't open a mapped file for writing, so unmap it while the header is patched.
+    if (sourceState == SourceState::Touched) {
+        outData.File.Close();
+        UpdateSourceModifiedTime(path, sourceModifiedTime);
+
+        if (!outData.File.Open(path) || outData.File.Size() != fileSize) {
+            outData.File.Close();
+            return false;
+        }
+    }
+
+    const bool valid = (header.IndexSize == 2 || header.IndexSize == 4) && header.SurfaceCount > 0
+        && SectionFits(header.VertexOffset, header.VertexCount, sizeof(Vertex), fileSize)
+        && SectionFits(header.IndexOffset, header.IndexCount, header.IndexSize, fileSize)
+        && SectionFits(header.SurfaceOffset, header.SurfaceCount, sizeof(uint32_t), fileSize)
+        && SectionFits(header.NameOffset, header.NameLength, 1, fileSize);
+
+    if (!valid) {
+        std::cout << "MeshCache: " << path << " is damaged." << std::endl;
+        outData.File.Close();
+        return false;
+    }
+
+    const char* data = outData.File.Data();
+    const uint32_t* surfaceIndexCounts = reinterpret_cast<const uint32_t*>(data + header.SurfaceOffset);
+
+    // The surfaces have to cover the indices exactly, or drawing one would read past the index buffer.
+    uint64_t surfaceIndices = 0;
+    for (uint32_t i = 0; i < header.SurfaceCount; i++) {
+        surfaceIndices += surfaceIndexCounts[i];
+    }
+
+    // Every index has to name a vertex, or GL would read past the vertex buffer.
+    const bool indicesInRange = (header.IndexSize == 2)
+        ? IndicesInRange(reinterpret_cast<const uint16_t*>(data + header.IndexOffset), header.IndexCount, header.VertexCount)
+        : IndicesInRange(reinterpret_cast<const uint32_t*>(data + header.IndexOffset), header.IndexCount, header.VertexCount);
+
+    if (surfaceIndices != header.IndexCount || !indicesInRange) {
+        std::cout << "MeshCache: " << path << " is damaged." << std::endl;
+        outData.File.Close();
+        return false;
+    }
+
+    outData.Name.assign(data + header.NameOffset, header.NameLength);
+    outData.Vertices = reinterpret_cast<const Vertex*>(data + header.VertexOffset);
+    outData.VertexCount = static_cast<size_t>(header.VertexCount);
+    outData.Indices = data + header.IndexOffset;
+    outData.IndexSize = header.IndexSize;
+    outData.IndexCount = static_cast<size_t>(header.IndexCount);
+    outData.SurfaceIndexCounts = surfaceIndexCounts;
+    outData.SurfaceCount = header.SurfaceCount;
+    outData.BoundsMin = header.BoundsMin;
+    outData.BoundsMax = header.BoundsMax;
+
+    return true;
+}
@@ -1,11 +1,15 @@
 #include <glad/glad.h>
 
+#include <cstddef>
 #include <cstdint>
 
 #include "vectorMath.h"
 #include "material.h"
 #include "renderable.h"
 
+// DrawRenderable passes a Matrix to GL as 16 floats.
+static_assert(sizeof(Matrix) == 16 * sizeof(GLfloat), "Matrix must be 16 tightly packed floats.");
+
 void FreeMesh(Mesh* mesh) {
 
     if (mesh->ElementBufferObject != GL_NONE) {
@@ -51,16 +55,26 @@ void FreeSubMesh(Mesh* mesh) {
 }
 
 
-void UploadMesh(Mesh* mesh, const  uint16_t* indeciesArray, const  Vector3* vertexBufferArray, const  Vector3* normalBufferArray, const Vector2* tCoordArray, const  size_t indecies, const  size_t vertecies) {
+static void SetIndexFormat(Mesh* mesh, const GLenum indexType, const size_t indecies) {
+    mesh->indexType = indexType;
+    mesh->indexCount = static_cast<GLsizei>(indecies);
+}
+
+static size_t IndexBytes(const GLenum indexType, const size_t indecies) {
+    return indecies * ((indexType == GL_UNSIGNED_INT) ? sizeof(uint32_t) : sizeof(uint16_t));
+}
+
+
+static void UploadMesh(Mesh* mesh, const void* indeciesArray, const GLenum indexType, const  Vector3* vertexBufferArray, const  Vector3* normalBufferArray, const Vector2* tCoordArray, const  size_t indecies, const  size_t vertecies) {
     /* Uploading mesh to GPU. points and normalBuffer must exist for the upload to work.
     tCoord data and face data is optional. */
 
     size_t vertexBytes = vertecies * sizeof(Vector3);
     size_t tCoordBytes = vertecies * sizeof(Vector2);
-    size_t indexBytes = indecies * sizeof(uint16_t);
+    size_t indexBytes = IndexBytes(indexType, indecies);
     size_t normalBytes = vertexBytes;
 
-    mesh->indexBytes = indexBytes;
+    SetIndexFormat(mesh, indexType, indecies);
 
     // Create a Vertex Attribute Object. This is kind of like a container for the buffer objects.              
     if (mesh->VertexAttributeObject == GL_NONE) { glGenVertexArrays(1, &(mesh->VertexAttributeObject)); }
@@ -102,31 +116,90 @@ void UploadMesh(Mesh* mesh, const  uint16_t* indeciesArray, const  Vector3* vert
 
 }
 
-void UploadSubMesh(Mesh* mesh, Mesh* source, const uint16_t* indeciesArray, const uint16_t indecies) {
+void UploadMesh(Mesh* mesh, const  uint16_t* indeciesArray, const  Vector3* vertexBufferArray, const  Vector3* normalBufferArray, const Vector2* tCoordArray, const  size_t indecies, const  size_t vertecies) {
+    UploadMesh(mesh, indeciesArray, GL_UNSIGNED_SHORT, vertexBufferArray, normalBufferArray, tCoordArray, indecies, vertecies);
+}
+
+void UploadMesh(Mesh* mesh, const  uint32_t* indeciesArray, const  Vector3* vertexBufferArray, const  Vector3* normalBufferArray, const Vector2* tCoordArray, const  size_t indecies, const  size_t vertecies) {
+    UploadMesh(mesh, indeciesArray, GL_UNSIGNED_INT, vertexBufferArray, normalBufferArray, tCoordArray, indecies, vertecies);
+}
+
+static void BindInterleavedAttributes() {
+    /* Point attributes 0, 1 and 2 at the position, normal and UV of each Vertex in the bound array buffer. */
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, position)));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, normal)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, textureCoord)));
+    glEnableVertexAttribArray(2);
+}
+
+static void UploadInterleavedMesh(Mesh* mesh, const void* indeciesArray, const GLenum indexType, const Vertex* vertexArray, const size_t indecies, const size_t vertecies) {
+    /* Variant of UploadMesh with every attribute in one buffer, so each vertex is fetched from one place. */
+
+    size_t indexBytes = IndexBytes(indexType, indecies);
+
+    SetIndexFormat(mesh, indexType, indecies);
+    mesh->interleaved = true;
+
+    if (mesh->VertexAttributeObject == GL_NONE) { glGenVertexArrays(1, &(mesh->VertexAttributeObject)); }
+    glBindVertexArray(mesh->VertexAttributeObject);
+
+    if (mesh->VertexBufferObject == GL_NONE) { glGenBuffers(1, &(mesh->VertexBufferObject)); }
+    glBindBuffer(GL_ARRAY_BUFFER, mesh->VertexBufferObject);
+    glBufferData(GL_ARRAY_BUFFER, vertecies * sizeof(Vertex), vertexArray, GL_STATIC_DRAW);
+    BindInterleavedAttributes();
+
+    if (mesh->ElementBufferObject == GL_NONE) { glGenBuffers(1, &(mesh->ElementBufferObject)); }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->ElementBufferObject);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, indeciesArray, GL_STATIC_DRAW);
+
+    glBindVertexArray(GL_NONE);
+    glBindBuffer(GL_ARRAY_BUFFER, GL_NONE);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_NONE);
+}
+
+void UploadInterleavedMesh(Mesh* mesh, const uint16_t* indeciesArray, const Vertex* vertexArray, const size_t indecies, const size_t vertecies) {
+    UploadInterleavedMesh(mesh, indeciesArray, GL_UNSIGNED_SHORT, vertexArray, indecies, vertecies);
+}
+
+void UploadInterleavedMesh(Mesh* mesh, const uint32_t* indeciesArray, const Vertex* vertexArray, const size_t indecies, const size_t vertecies) {
+    UploadInterleavedMesh(mesh, indeciesArray, GL_UNSIGNED_INT, vertexArray, indecies, vertecies);
+}
+
+static void UploadSubMesh(Mesh* mesh, Mesh* source, const void* indeciesArray, const GLenum indexType, const size_t indecies) {
     /* variant of UploadMesh for meshes that share vertices but have a different element buffer. */
 
-    size_t indexBytes = indecies * sizeof(uint16_t);
-    mesh->indexBytes = indexBytes;
+    size_t indexBytes = IndexBytes(indexType, indecies);
+    SetIndexFormat(mesh, indexType, indecies);
 
     if (mesh->VertexAttributeObject == GL_NONE) {
         glGenVertexArrays(1, &(mesh->VertexAttributeObject));
     }
     glBindVertexArray(mesh->VertexAttributeObject);
 
+    mesh->interleaved = source->interleaved;
     mesh->VertexBufferObject = source->VertexBufferObject;
     glBindBuffer(GL_ARRAY_BUFFER, mesh->VertexBufferObject);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3), nullptr);
-    glEnableVertexAttribArray(0);
 
-    mesh->NormalBufferObject = source->NormalBufferObject;
-    glBindBuffer(GL_ARRAY_BUFFER, mesh->NormalBufferObject);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3), nullptr);
-    glEnableVertexAttribArray(1);
+    if (source->interleaved) {
+        BindInterleavedAttributes();
+    }
+    else {
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3), nullptr);
+        glEnableVertexAttribArray(0);
 
-    mesh->TextureCoordBufferObject = source->TextureCoordBufferObject;
-    glBindBuffer(GL_ARRAY_BUFFER, mesh->TextureCoordBufferObject);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vector2), nullptr);
-    glEnableVertexAttribArray(2);
+        mesh->NormalBufferObject = source->NormalBufferObject;
+        glBindBuffer(GL_ARRAY_BUFFER, mesh->NormalBufferObject);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3), nullptr);
+        glEnableVertexAttribArray(1);
+
+        mesh->TextureCoordBufferObject = source->TextureCoordBufferObject;
+        glBindBuffer(GL_ARRAY_BUFFER, mesh->TextureCoordBufferObject);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vector2), nullptr);
+        glEnableVertexAttribArray(2);
+    }
 
     if (mesh->ElementBufferObject == GL_NONE) { glGenBuffers(1, &(mesh->ElementBufferObject)); }
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->ElementBufferObject);
@@ -138,6 +211,14 @@ void UploadSubMesh(Mesh* mesh, Mesh* source, const uint16_t* indeciesArray, cons
 
 }
 
+void UploadSubMesh(Mesh* mesh, Mesh* source, const uint16_t* indeciesArray, const size_t indecies) {
+    UploadSubMesh(mesh, source, indeciesArray, GL_UNSIGNED_SHORT, indecies);
+}
+
+void UploadSubMesh(Mesh* mesh, Mesh* source, const uint32_t* indeciesArray, const size_t indecies) {
+    UploadSubMesh(mesh, source, indeciesArray, GL_UNSIGNED_INT, indecies);
+}
+
 
 void DrawRenderable(const Mesh* mesh, const Material* material, const Matrix* transform, const GLfloat time) {
     // Bind the material's shader program and textures.
@@ -151,8 +232,9 @@ void DrawRenderable(const Mesh* mesh, const Material* material, const Matrix* tr
     // Bind the VAO and draw the elements.
     glBindVertexArray(mesh->VertexAttributeObject);
     glUniform1f(u_time, time);
-    glUniformMatrix4fv(u_mvp, 1, GL_FALSE, ToFloat16(*transform).v);
-    glDrawElements(GL_TRIANGLES, mesh->indexBytes, GL_UNSIGNED_SHORT, 0);
+    // A Matrix is stored row by row, so GL transposes it during the upload instead of us copying it with ToFloat16.
+    glUniformMatrix4fv(u_mvp, 1, GL_TRUE, reinterpret_cast<const GLfloat*>(transform));
+    glDrawElements(GL_TRIANGLES, mesh->indexCount, mesh->indexType, 0);
 
     // unbind the VAO.
     glBindVertexArray(GL_NONE);
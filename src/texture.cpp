@@ -5,16 +5,37 @@
 #include <cassert>
 #include <cstring>
 #include <iostream>
+#include <new>
 
+#include "asset.h"
 #include "hashTable.h"
+#include "slabPool.h"
 #include "texture.h"
 
-static HashTable<Texture> TextureTable(512);
+// Textures get streamed in while the game is running, so spread out the cost of resizing the table.
+static HashTable<Texture> TextureTable(512, true);
+
+void* Texture::operator new(size_t size) {
+    assert(size == sizeof(Texture));
+    void* memory = GetSlabPool<Texture>(ObjectType::Texture).Allocate();
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void Texture::operator delete(void* texture) {
+    GetSlabPool<Texture>(ObjectType::Texture).Free(texture);
+}
 
 bool TextureManager::FindTexture(const char* alias, Texture*& outValue) {
     return TextureTable.Find(alias, outValue);
 }
 
+bool TextureManager::FindTexture(const StringId& alias, Texture*& outValue) {
+    return TextureTable.Find(alias, outValue);
+}
+
 void TextureManager::InternalUploadTexture(Texture* texture, uint8_t* data, GLenum internalFormat, GLenum format) {
     glGenTextures(1, &texture->ID);
     glBindTexture(GL_TEXTURE_2D, texture->ID);
@@ -42,11 +63,16 @@ void TextureManager::InternalDeleteTexture(Texture* texture) {
             glDeleteTextures(1, &(texture->ID));
         }
         texture->ID = GL_NONE;
-        TextureTable.Delete(texture->alias);
+
+        // Managed textures are freed by Delete, so take the alias off the texture first.
+        char* alias = texture->alias;
+        texture->alias = nullptr;
+        TextureTable.Delete(alias);
+        delete[] alias;
     }
 }
 
-void TextureManager::InternalCreateTexture(Texture* texture, const bool isManaged, const char* alias, const GLenum internalFormat, const GLenum format, uint8_t* data, bool useMipmap) {
+void TextureManager::InternalCreateTexture(Texture* texture, const bool isManaged, const StringId& alias, const GLenum internalFormat, const GLenum format, uint8_t* data, bool useMipmap) {
     /* Internal function for creating managed textures. */
 
     if (useMipmap) {
@@ -56,7 +82,9 @@ void TextureManager::InternalCreateTexture(Texture* texture, const bool isManage
         TextureManager::InternalUploadTexture(texture, data, internalFormat, format);
     }
 
-    texture->alias = TextureTable.Insert(alias, texture, isManaged);
+    // The table's copy of the key moves when the table resizes, so the texture keeps its own.
+    texture->alias = CopyString(alias);
+    TextureTable.Insert(alias, texture, isManaged);
     texture->references++;
 
 }
@@ -74,8 +102,8 @@ void TextureManager::CreateRawTexture(const char* path, Texture* texture, GLenum
         return;
     }
 
-    // Create the managed texture and upload the texture to the GPU.
-    TextureManager::InternalCreateTexture(texture, true, path, internalFormat, format, data, useMipmaps);
+    // The caller owns the texture, so the table doesn't manage it. Upload the texture to the GPU.
+    TextureManager::InternalCreateTexture(texture, false, path, internalFormat, format, data, useMipmaps);
 
     // Free the data generated by stb_image.
     stbi_image_free(data);
@@ -93,8 +121,11 @@ Texture* CreateTexture(const char* path, const char* alias, GLenum internalForma
     if (!strcmp(alias, "")) { aliasUsed = const_cast<char*>(path); }
     else { aliasUsed = const_cast<char*>(alias); }
 
+    // Hash the alias once, it gets used for both the lookup and the insert.
+    StringId aliasId(aliasUsed);
+
     // try to find the texture in the table.
-    TextureTable.Find(aliasUsed, texture);
+    TextureTable.Find(aliasId, texture);
 
     // if the texture doesn't already exist, make a new one, and return that instead.
     if (texture != nullptr) {
@@ -113,7 +144,7 @@ Texture* CreateTexture(const char* path, const char* alias, GLenum internalForma
     }
 
     // Create the managed texture and upload the texture to the GPU.
-    TextureManager::InternalCreateTexture(texture, false, aliasUsed, internalFormat, format, data, useMipmaps);
+    TextureManager::InternalCreateTexture(texture, true, aliasId, internalFormat, format, data, useMipmaps);
 
     // Free the data generated by stb_image.
     stbi_image_free(data);
@@ -143,11 +174,14 @@ void DeleteTexture(const char* alias) {
 void DereferenceTextures() {
     /* Call this function at the end of your program to ensure all tracked textures are properly cleaned up. */
 
+    // Make sure every texture is in the current array before walking over it.
+    TextureTable.FinishMigration();
+
     // Iterate through all the positions in the hash table.
     for (uint64_t i = 0; i < TextureTable.Size; i++) {
 
         // Check if there is a value stored here:
-        if (TextureTable.Array[i].Key == nullptr) {
+        if (!TextureTable.SlotUsed(i)) {
             continue;
         }
 
@@ -0,0 +1,419 @@
+#include <cassert>
+#include <iostream>
+
+#include "jobSystem.h"
+#include "transform.h"
+
+
+TransformStore& GetTransformStore() {
+    // Created on first use, so assets constructed during static initialization still get a valid store.
+    static TransformStore store(1024);
+    return store;
+}
+
+
+TransformStore::TransformStore(uint32_t capacity) {
+    Positions.reserve(capacity);
+    Rotations.reserve(capacity);
+    Scales.reserve(capacity);
+    WorldMatrices.reserve(capacity);
+    Parents.reserve(capacity);
+    Flags.reserve(capacity);
+    Handles.reserve(capacity);
+    Sparse.reserve(capacity);
+    FreeHead = INVALID_TRANSFORM;
+    FirstDirty = 0;
+    NeedsSort = false;
+    LevelsValid = false;
+}
+
+TransformHandle TransformStore::Create() {
+    /* Add an identity transform with no parent to the end of the arrays. */
+
+    TransformHandle handle;
+
+    // Reuse a freed handle if there is one.
+    if (FreeHead != INVALID_TRANSFORM) {
+        handle = FreeHead;
+        FreeHead = Sparse[handle];
+    }
+    else {
+        handle = static_cast<TransformHandle>(Sparse.size());
+        Sparse.push_back(0);
+    }
+
+    Sparse[handle] = Count();
+
+    Positions.push_back(Vector3{ 0.0f, 0.0f, 0.0f });
+    Rotations.push_back(QuaternionIdentity());
+    Scales.push_back(Vector3{ 1.0f, 1.0f, 1.0f });
+    WorldMatrices.push_back(MatrixIdentity());
+    Parents.push_back(INVALID_TRANSFORM);
+    Flags.push_back(TransformFlags::None);
+    Handles.push_back(handle);
+
+    // Roots can go anywhere, so the end of the arrays keeps the parent order, but not the depth order. The world
+    // matrix is already right.
+    LevelsValid = false;
+    return handle;
+}
+
+void TransformStore::Delete(TransformHandle handle) {
+    /* Remove a transform by moving the last one into its place. Children of the transform become roots. */
+
+    if (!IsValid(handle)) {
+        std::cout << "TransformStore: Tried to delete transform " << handle << ", which does not exist." << std::endl;
+        return;
+    }
+
+    const uint32_t index = Sparse[handle];
+    const uint32_t last = Count() - 1;
+
+    // Children come after their parent, so only the rest of the arrays needs checking, unless a sort is pending.
+    for (uint32_t i = NeedsSort ? 0 : index + 1; i < Count(); i++) {
+        if (Parents[i] == handle) {
+            Parents[i] = INVALID_TRANSFORM;
+            MarkDirty(i);
+        }
+    }
+
+    if (index != last) {
+        Positions[index] = Positions[last];
+        Rotations[index] = Rotations[last];
+        Scales[index] = Scales[last];
+        WorldMatrices[index] = WorldMatrices[last];
+        Parents[index] = Parents[last];
+        Flags[index] = Flags[last];
+        Handles[index] = Handles[last];
+        Sparse[Handles[index]] = index;
+
+        // The moved transform is now earlier than before, which could put it ahead of its parent.
+        if (Parents[index] != INVALID_TRANSFORM && Sparse[Parents[index]] > index) {
+            NeedsSort = true;
+        }
+
+        if (Flags[index] & TransformFlags::Dirty) {
+            FirstDirty = (index < FirstDirty) ? index : FirstDirty;
+        }
+    }
+
+    Positions.pop_back();
+    Rotations.pop_back();
+    Scales.pop_back();
+    WorldMatrices.pop_back();
+    Parents.pop_back();
+    Flags.pop_back();
+    Handles.pop_back();
+
+    Sparse[handle] = FreeHead;
+    FreeHead = handle;
+    LevelsValid = false;
+
+    if (FirstDirty > Count()) {
+        FirstDirty = Count();
+    }
+}
+
+bool TransformStore::IsValid(TransformHandle handle) const {
+    // A freed handle's entry points at another handle, or nowhere, so check it points back.
+    return handle < Sparse.size() && Sparse[handle] < Count() && Handles[Sparse[handle]] == handle;
+}
+
+uint32_t TransformStore::GetIndex(TransformHandle handle) const {
+    assert(IsValid(handle));
+    return Sparse[handle];
+}
+
+void TransformStore::MarkDirty(uint32_t index) {
+    Flags[index] |= TransformFlags::Dirty;
+    FirstDirty = (index < FirstDirty) ? index : FirstDirty;
+}
+
+TRS TransformStore::GetLocal(TransformHandle handle) const {
+    const uint32_t index = GetIndex(handle);
+    return TRS{ Positions[index], Rotations[index], Scales[index] };
+}
+
+void TransformStore::SetLocal(TransformHandle handle, TRS local) {
+    const uint32_t index = GetIndex(handle);
+    Positions[index] = local.translation;
+    Rotations[index] = local.rotation;
+    Scales[index] = local.scale;
+    MarkDirty(index);
+}
+
+Matrix TransformStore::GetLocalMatrix(TransformHandle handle) const {
+    return LocalMatrix(GetIndex(handle));
+}
+
+void TransformStore::SetLocalMatrix(TransformHandle handle, Matrix local) {
+    SetLocal(handle, ToTRS(local));
+}
+
+const Matrix* TransformStore::GetWorldMatrix(TransformHandle handle) const {
+    return &WorldMatrices[GetIndex(handle)];
+}
+
+Vector3 TransformStore::GetPosition(TransformHandle handle) const {
+    return Positions[GetIndex(handle)];
+}
+
+Quaternion TransformStore::GetRotation(TransformHandle handle) const {
+    return Rotations[GetIndex(handle)];
+}
+
+Vector3 TransformStore::GetScale(TransformHandle handle) const {
+    return Scales[GetIndex(handle)];
+}
+
+void TransformStore::SetPosition(TransformHandle handle, Vector3 position) {
+    const uint32_t index = GetIndex(handle);
+    Positions[index] = position;
+    MarkDirty(index);
+}
+
+void TransformStore::SetRotation(TransformHandle handle, Quaternion rotation) {
+    const uint32_t index = GetIndex(handle);
+    Rotations[index] = rotation;
+    MarkDirty(index);
+}
+
+void TransformStore::SetScale(TransformHandle handle, Vector3 scale) {
+    const uint32_t index = GetIndex(handle);
+    Scales[index] = scale;
+    MarkDirty(index);
+}
+
+TransformHandle TransformStore::GetParent(TransformHandle handle) const {
+    return Parents[GetIndex(handle)];
+}
+
+void TransformStore::SetParent(TransformHandle handle, TransformHandle parent) {
+    /* Pass INVALID_TRANSFORM to make the transform a root. */
+
+    if (parent != INVALID_TRANSFORM && !IsValid(parent)) {
+        std::cout << "TransformStore: Tried to parent transform " << handle << " to " << parent << ", which does not exist." << std::endl;
+        return;
+    }
+
+    // Refuse to make a cycle, since the world matrix would never be finished.
+    for (TransformHandle ancestor = parent; ancestor != INVALID_TRANSFORM; ancestor = Parents[Sparse[ancestor]]) {
+        if (ancestor == handle) {
+            std::cout << "TransformStore: Tried to parent transform " << handle << " to its own child." << std::endl;
+            return;
+        }
+    }
+
+    const uint32_t index = GetIndex(handle);
+    Parents[index] = parent;
+    MarkDirty(index);
+    LevelsValid = false;
+
+    if (parent != INVALID_TRANSFORM && Sparse[parent] > index) {
+        NeedsSort = true;
+    }
+}
+
+Matrix TransformStore::LocalMatrix(uint32_t index) const {
+    return ToMatrix(TRS{ Positions[index], Rotations[index], Scales[index] });
+}
+
+Matrix TransformStore::ComputeWorldMatrix(TransformHandle handle) const {
+
+    uint32_t index = GetIndex(handle);
+    Matrix result = LocalMatrix(index);
+
+    while (Parents[index] != INVALID_TRANSFORM) {
+        index = Sparse[Parents[index]];
+        result = result * LocalMatrix(index);
+    }
+
+    return result;
+}
+
+Matrix TransformStore::GetGlobalMatrix(TransformHandle handle) const {
+
+    // Only the transforms that were changed directly are marked until the next update, so check every ancestor.
+    for (uint32_t index = GetIndex(handle);; index = Sparse[Parents[index]]) {
+
+        if (Flags[index] & TransformFlags::Dirty) {
+            return ComputeWorldMatrix(handle);
+        }
+
+        if (Parents[index] == INVALID_TRANSFORM) {
+            return WorldMatrices[GetIndex(handle)];
+        }
+    }
+}
+
+void TransformStore::SortHierarchy() {
+    /* Reorder the arrays so every transform comes after its parent. Transforms are sorted by depth in the hierarchy,
+    keeping their current order within a depth. */
+
+    const uint32_t count = Count();
+    std::vector<uint32_t> depths(count, INVALID_TRANSFORM);
+    std::vector<uint32_t> chain;
+    uint32_t maxDepth = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+
+        // Walk up until a transform with a known depth, then fill in the depths on the way back down.
+        uint32_t index = i;
+        chain.clear();
+        while (depths[index] == INVALID_TRANSFORM && Parents[index] != INVALID_TRANSFORM) {
+            chain.push_back(index);
+            index = Sparse[Parents[index]];
+        }
+
+        uint32_t depth = (depths[index] == INVALID_TRANSFORM) ? 0 : depths[index];
+        depths[index] = depth;
+
+        for (uint32_t c = static_cast<uint32_t>(chain.size()); c > 0; c--) {
+            depths[chain[c - 1]] = ++depth;
+        }
+        maxDepth = (depth > maxDepth) ? depth : maxDepth;
+    }
+
+    // Counting sort by depth.
+    std::vector<uint32_t> levelStart(maxDepth + 2, 0);
+    for (uint32_t i = 0; i < count; i++) {
+        levelStart[depths[i] + 1]++;
+    }
+    for (uint32_t d = 0; d <= maxDepth; d++) {
+        levelStart[d + 1] += levelStart[d];
+    }
+
+    std::vector<uint32_t> order(count);
+    for (uint32_t i = 0; i < count; i++) {
+        order[levelStart[depths[i]]++] = i;
+    }
+
+    // Filling in the order moved every level start to the start of the next level.
+    LevelStart.assign(1, 0);
+    LevelStart.insert(LevelStart.end(), levelStart.begin(), levelStart.end() - 1);
+
+    std::vector<Vector3> positions(count);
+    std::vector<Quaternion> rotations(count);
+    std::vector<Vector3> scales(count);
+    std::vector<Matrix> worldMatrices(count);
+    std::vector<TransformHandle> parents(count);
+    std::vector<uint8_t> flags(count);
+    std::vector<TransformHandle> handles(count);
+
+    FirstDirty = count;
+
+    for (uint32_t i = 0; i < count; i++) {
+        const uint32_t from = order[i];
+        positions[i] = Positions[from];
+        rotations[i] = Rotations[from];
+        scales[i] = Scales[from];
+        worldMatrices[i] = WorldMatrices[from];
+        parents[i] = Parents[from];
+        flags[i] = Flags[from];
+        handles[i] = Handles[from];
+
+        if ((flags[i] & TransformFlags::Dirty) && FirstDirty == count) {
+            FirstDirty = i;
+        }
+    }
+
+    Positions.swap(positions);
+    Rotations.swap(rotations);
+    Scales.swap(scales);
+    WorldMatrices.swap(worldMatrices);
+    Parents.swap(parents);
+    Flags.swap(flags);
+    Handles.swap(handles);
+
+    for (uint32_t i = 0; i < count; i++) {
+        Sparse[Handles[i]] = i;
+    }
+
+    NeedsSort = false;
+    LevelsValid = true;
+}
+
+void TransformStore::UpdateRange(uint32_t first, uint32_t last) {
+    /* Recompute each transform in [first, last) that is dirty, or whose parent was dirty. Every parent must already
+    be finished, and parents pass their flag down to their children. */
+
+    for (uint32_t i = first; i < last; i++) {
+
+        const TransformHandle parentHandle = Parents[i];
+        const uint32_t parent = (parentHandle == INVALID_TRANSFORM) ? INVALID_TRANSFORM : Sparse[parentHandle];
+        uint8_t flags = Flags[i];
+
+        if (parent != INVALID_TRANSFORM && (Flags[parent] & TransformFlags::Dirty)) {
+            flags |= TransformFlags::Dirty;
+            Flags[i] = flags;
+        }
+
+        if (!(flags & TransformFlags::Dirty)) {
+            continue;
+        }
+
+        const Matrix local = LocalMatrix(i);
+        WorldMatrices[i] = (parent == INVALID_TRANSFORM) ? local : local * WorldMatrices[parent];
+    }
+}
+
+void TransformStore::UpdateTransforms() {
+    /* One pass from the first dirty transform to the end. A transform is recomputed if it was changed or its parent
+    was recomputed, which works because parents are always earlier in the arrays. Clean subtrees only cost reading
+    their flags and parents. */
+
+    if (NeedsSort) {
+        SortHierarchy();
+    }
+
+    const uint32_t count = Count();
+    const uint32_t first = FirstDirty;
+
+    if (first >= count) {
+        return;
+    }
+
+    UpdateRange(first, count);
+
+    // Children read their parent's flag above, so the flags can only be cleared once everything is done.
+    for (uint32_t i = first; i < count; i++) {
+        Flags[i] &= ~TransformFlags::Dirty;
+    }
+
+    FirstDirty = count;
+}
+
+void TransformStore::UpdateTransforms(JobSystem& jobs) {
+    /* Same as UpdateTransforms(), with each level of the hierarchy split across the job system. Levels still run
+    one after the other, since a level needs the world matrices of the one above it. */
+
+    if (NeedsSort || !LevelsValid) {
+        SortHierarchy();
+    }
+
+    const uint32_t count = Count();
+    const uint32_t first = FirstDirty;
+
+    if (first >= count) {
+        return;
+    }
+
+    auto update = [this](uint32_t begin, uint32_t end) { UpdateRange(begin, end); };
+    auto clear = [this](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            Flags[i] &= ~TransformFlags::Dirty;
+        }
+    };
+
+    for (uint32_t level = 0; level + 1 < LevelStart.size(); level++) {
+
+        // Everything before the first dirty transform is clean, including whole levels.
+        const uint32_t begin = (LevelStart[level] > first) ? LevelStart[level] : first;
+        const uint32_t end = LevelStart[level + 1];
+
+        jobs.ParallelFor(begin, end, TRANSFORM_BATCH_SIZE, update);
+    }
+
+    jobs.ParallelFor(first, count, TRANSFORM_BATCH_SIZE * 16, clear);
+    FirstDirty = count;
+}
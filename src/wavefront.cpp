@@ -0,0 +1,640 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include "jobSystem.h"
+#include "mappedFile.h"
+#include "wavefront.h"
+
+// The file is read in place: every token is parsed straight out of the text, line by line, with no copies and no
+// allocation other than growing the output lists. Large files are cut into chunks of whole lines that are parsed on
+// every thread of a JobSystem, then merged in file order.
+
+// Every power of ten a double holds exactly.
+static const double ExactPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+
+void WavefrontData::Clear() {
+    Name = "None";
+    Positions.clear();
+    TextureCoords.clear();
+    Normals.clear();
+    PositionIndices.clear();
+    TextureCoordIndices.clear();
+    NormalIndices.clear();
+    SurfaceIndexCounts.clear();
+}
+
+
+static const char* SkipBlanks(const char* cursor, const char* end) {
+    // '\r' counts as a blank, so files with Windows line endings parse the same.
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) {
+        cursor++;
+    }
+    return cursor;
+}
+
+static const char* SkipLine(const char* cursor, const char* end) {
+    if (cursor >= end) {
+        return end;
+    }
+
+    const char* newline = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+    return (newline == nullptr) ? end : newline + 1;
+}
+
+static bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static bool ParseFloat(const char*& cursor, const char* end, float& outValue) {
+    /* Parse a decimal number like -1.25e-3. The digits are gathered into one 64 bit integer and scaled by a power of
+    ten once at the end, which is exact for the 6 to 9 significant digits exporters write. */
+
+    const char* p = SkipBlanks(cursor, end);
+
+    const bool negative = (p < end && *p == '-');
+    if (p < end && (*p == '-' || *p == '+')) {
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    const char* firstDigit = p;
+
+    for (; p < end && IsDigit(*p); p++) {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+            digits += (mantissa != 0);
+        }
+        else {
+            exponent++;
+        }
+    }
+
+    if (p < end && *p == '.') {
+        p++;
+        for (; p < end && IsDigit(*p); p++) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                digits += (mantissa != 0);
+                exponent--;
+            }
+        }
+    }
+
+    // Not even one digit, before or after the point.
+    if (p == firstDigit || (p == firstDigit + 1 && *firstDigit == '.')) {
+        return false;
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        const bool negativeExponent = (p < end && *p == '-');
+        if (p < end && (*p == '-' || *p == '+')) {
+            p++;
+        }
+        if (p == end || !IsDigit(*p)) {
+            return false;
+        }
+
+        int value = 0;
+        for (; p < end && IsDigit(*p); p++) {
+            value = (value < 10000) ? value * 10 + (*p - '0') : value;
+        }
+        exponent += negativeExponent ? -value : value;
+    }
+
+    double result = static_cast<double>(mantissa);
+
+    if (exponent < 0) {
+        result = (exponent >= -22) ? result / ExactPowersOfTen[-exponent] : result * pow(10.0, exponent);
+    }
+    else if (exponent > 0) {
+        result = (exponent <= 22) ? result * ExactPowersOfTen[exponent] : result * pow(10.0, exponent);
+    }
+
+    outValue = static_cast<float>(negative ? -result : result);
+    cursor = p;
+    return true;
+}
+
+static bool ParseIndex(const char*& cursor, const char* end, int64_t& outValue) {
+    /* Parse a face index, which is one based and negative when counted back from the newest element. */
+
+    const char* p = cursor;
+
+    const bool negative = (p < end && *p == '-');
+    if (negative) {
+        p++;
+    }
+
+    if (p == end || !IsDigit(*p)) {
+        return false;
+    }
+
+    int64_t value = 0;
+    for (; p < end && IsDigit(*p); p++) {
+        value = (value < 0xFFFFFFFFll) ? value * 10 + (*p - '0') : value;
+    }
+
+    outValue = negative ? -value : value;
+    cursor = p;
+    return true;
+}
+
+struct WavefrontChunk {
+    /* What one run of whole lines holds, parsed on its own. Positive indices are absolute and already final.
+    Negative ones count back from a position in the file, which isn't known until every earlier chunk has been
+    counted, so they are kept aside with the count they are relative to and fixed up in the merge. */
+
+    struct RelativeIndex {
+        uint32_t Corner;        // Where the index goes in this chunk's index lists.
+        uint32_t Attribute;     // 0 for positions, 1 for texture coordinates, 2 for normals.
+        int64_t Index;          // Zero based index relative to the start of this chunk, may be negative.
+    };
+
+    const char* Begin = nullptr;
+    const char* End = nullptr;
+
+    std::vector<Vector3> Positions;
+    std::vector<Vector2> TextureCoords;
+    std::vector<Vector3> Normals;
+
+    std::vector<uint32_t> PositionIndices;
+    std::vector<uint32_t> TextureCoordIndices;
+    std::vector<uint32_t> NormalIndices;
+
+    std::vector<RelativeIndex> RelativeIndices;
+
+    // The number of corners in this chunk before each usemtl.
+    std::vector<uint32_t> SurfaceStarts;
+
+    std::string Name;
+    bool HasName = false;
+
+    // The start of the first malformed line, or nullptr.
+    const char* ErrorLine = nullptr;
+
+    // How many positions, texture coordinates, normals and corners this chunk has, and where they start in the
+    // merged lists. Set by the merge.
+    size_t Counts[4] = { 0, 0, 0, 0 };
+    size_t Offsets[4] = { 0, 0, 0, 0 };
+};
+
+struct Corner {
+    /* One parsed face corner. Attributes with a bit set in RelativeMask came from negative indices and are in
+    Relative instead of Index. */
+
+    uint32_t Index[3];
+    int64_t Relative[3];
+    uint32_t RelativeMask;
+};
+
+
+static bool ResolveIndex(int64_t index, size_t count, uint32_t attribute, Corner& outCorner) {
+    /* Turn an .obj index into a zero based one. Positive indices are range checked once the whole file is read,
+    since they may point ahead. */
+
+    if (index > 0 && index <= 0xFFFFFFFEll) {
+        outCorner.Index[attribute] = static_cast<uint32_t>(index - 1);
+        return true;
+    }
+
+    if (index < 0) {
+        outCorner.Index[attribute] = 0;
+        outCorner.Relative[attribute] = static_cast<int64_t>(count) + index;
+        outCorner.RelativeMask |= 1u << attribute;
+        return true;
+    }
+
+    return false;
+}
+
+static bool ParseCorner(const char*& cursor, const char* end, const WavefrontChunk& chunk, Corner& outCorner) {
+    /* Parse one face corner: v, v/vt, v//vn or v/vt/vn. */
+
+    const char* p = cursor;
+    int64_t index = 0;
+
+    outCorner.Index[1] = WAVEFRONT_MISSING_INDEX;
+    outCorner.Index[2] = WAVEFRONT_MISSING_INDEX;
+    outCorner.RelativeMask = 0;
+
+    if (!ParseIndex(p, end, index) || !ResolveIndex(index, chunk.Positions.size(), 0, outCorner)) {
+        return false;
+    }
+
+    if (p < end && *p == '/') {
+        p++;
+
+        if (p < end && *p != '/') {
+            if (!ParseIndex(p, end, index) || !ResolveIndex(index, chunk.TextureCoords.size(), 1, outCorner)) {
+                return false;
+            }
+        }
+
+        if (p < end && *p == '/') {
+            p++;
+            if (!ParseIndex(p, end, index) || !ResolveIndex(index, chunk.Normals.size(), 2, outCorner)) {
+                return false;
+            }
+        }
+    }
+
+    cursor = p;
+    return true;
+}
+
+static void AddCorner(WavefrontChunk& chunk, const Corner& corner) {
+
+    if (corner.RelativeMask != 0) {
+        const uint32_t slot = static_cast<uint32_t>(chunk.PositionIndices.size());
+
+        for (uint32_t attribute = 0; attribute < 3; attribute++) {
+            if (corner.RelativeMask & (1u << attribute)) {
+                chunk.RelativeIndices.push_back({ slot, attribute, corner.Relative[attribute] });
+            }
+        }
+    }
+
+    chunk.PositionIndices.push_back(corner.Index[0]);
+    chunk.TextureCoordIndices.push_back(corner.Index[1]);
+    chunk.NormalIndices.push_back(corner.Index[2]);
+}
+
+static bool ParseFace(const char*& cursor, const char* end, WavefrontChunk& chunk) {
+    /* Split a face of any size into a fan of triangles around its first corner. */
+
+    Corner first;
+    Corner previous;
+    Corner current;
+    int corners = 0;
+
+    const char* p = SkipBlanks(cursor, end);
+
+    while (p < end && *p != '\n' && *p != '#') {
+        if (!ParseCorner(p, end, chunk, current)) {
+            return false;
+        }
+
+        if (corners == 0) {
+            first = current;
+        }
+        else if (corners >= 2) {
+            AddCorner(chunk, first);
+            AddCorner(chunk, previous);
+            AddCorner(chunk, current);
+        }
+
+        previous = current;
+        corners++;
+        p = SkipBlanks(p, end);
+    }
+
+    cursor = p;
+    return corners >= 3;
+}
+
+static bool StartsWith(const char* cursor, const char* end, const char* word) {
+    const size_t length = strlen(word);
+    return static_cast<size_t>(end - cursor) > length && memcmp(cursor, word, length) == 0 && (cursor[length] == ' ' || cursor[length] == '\t');
+}
+
+static void ParseChunk(WavefrontChunk& chunk) {
+    /* Parse every line in [Begin, End). Stops at the first malformed line and records it. */
+
+    const char* cursor = chunk.Begin;
+    const char* end = chunk.End;
+
+    while (cursor < end) {
+        cursor = SkipBlanks(cursor, end);
+        const char* line = cursor;
+        bool valid = true;
+
+        if (cursor == end) {
+            break;
+        }
+
+        if (StartsWith(cursor, end, "v")) {
+            Vector3 position = { 0.0f, 0.0f, 0.0f };
+            cursor++;
+            valid = ParseFloat(cursor, end, position.x) && ParseFloat(cursor, end, position.y) && ParseFloat(cursor, end, position.z);
+            chunk.Positions.push_back(position);
+        }
+        else if (StartsWith(cursor, end, "vt")) {
+            // A third coordinate, for 3D textures, is ignored.
+            Vector2 textureCoord = { 0.0f, 0.0f };
+            cursor += 2;
+            valid = ParseFloat(cursor, end, textureCoord.x) && ParseFloat(cursor, end, textureCoord.y);
+            chunk.TextureCoords.push_back(textureCoord);
+        }
+        else if (StartsWith(cursor, end, "vn")) {
+            Vector3 normal = { 0.0f, 0.0f, 0.0f };
+            cursor += 2;
+            valid = ParseFloat(cursor, end, normal.x) && ParseFloat(cursor, end, normal.y) && ParseFloat(cursor, end, normal.z);
+            chunk.Normals.push_back(normal);
+        }
+        else if (StartsWith(cursor, end, "f")) {
+            cursor++;
+            valid = ParseFace(cursor, end, chunk);
+        }
+        else if (StartsWith(cursor, end, "usemtl")) {
+            chunk.SurfaceStarts.push_back(static_cast<uint32_t>(chunk.PositionIndices.size()));
+        }
+        else if (StartsWith(cursor, end, "o")) {
+            const char* name = SkipBlanks(cursor + 1, end);
+            const char* nameEnd = SkipLine(name, end);
+            while (nameEnd > name && (nameEnd[-1] == '\n' || nameEnd[-1] == '\r' || nameEnd[-1] == ' ' || nameEnd[-1] == '\t')) {
+                nameEnd--;
+            }
+            chunk.Name.assign(name, nameEnd);
+            chunk.HasName = true;
+        }
+        // Everything else (comments, groups, smoothing, mtllib, lines and points) is skipped.
+
+        if (!valid) {
+            chunk.ErrorLine = line;
+            return;
+        }
+
+        cursor = SkipLine(cursor, end);
+    }
+}
+
+template<typename T> static void CopyInto(std::vector<T>& destination, size_t offset, const std::vector<T>& source) {
+    if (!source.empty()) {
+        memcpy(&destination[offset], source.data(), source.size() * sizeof(T));
+    }
+}
+
+static bool MergeChunk(const WavefrontChunk& chunk, WavefrontData& outData) {
+    /* Copy a chunk into its place in the merged lists, fix up its negative indices and range check every index.
+    Chunks write to separate ranges, so they can be merged in parallel. A chunk whose lists were moved straight into
+    outData has nothing left to copy. */
+
+    const size_t counts[3] = { outData.Positions.size(), outData.TextureCoords.size(), outData.Normals.size() };
+    const size_t corner = chunk.Offsets[3];
+
+    CopyInto(outData.Positions, chunk.Offsets[0], chunk.Positions);
+    CopyInto(outData.TextureCoords, chunk.Offsets[1], chunk.TextureCoords);
+    CopyInto(outData.Normals, chunk.Offsets[2], chunk.Normals);
+
+    CopyInto(outData.PositionIndices, corner, chunk.PositionIndices);
+    CopyInto(outData.TextureCoordIndices, corner, chunk.TextureCoordIndices);
+    CopyInto(outData.NormalIndices, corner, chunk.NormalIndices);
+
+    std::vector<uint32_t>* lists[3] = { &outData.PositionIndices, &outData.TextureCoordIndices, &outData.NormalIndices };
+
+    for (const WavefrontChunk::RelativeIndex& relative : chunk.RelativeIndices) {
+        const int64_t index = static_cast<int64_t>(chunk.Offsets[relative.Attribute]) + relative.Index;
+
+        if (index < 0) {
+            return false;
+        }
+        (*lists[relative.Attribute])[corner + relative.Corner] = static_cast<uint32_t>(index);
+    }
+
+    for (size_t i = corner; i < corner + chunk.Counts[3]; i++) {
+        const bool valid = outData.PositionIndices[i] < counts[0]
+            && (outData.TextureCoordIndices[i] < counts[1] || outData.TextureCoordIndices[i] == WAVEFRONT_MISSING_INDEX)
+            && (outData.NormalIndices[i] < counts[2] || outData.NormalIndices[i] == WAVEFRONT_MISSING_INDEX);
+
+        if (!valid) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ParseWavefront(const char* text, size_t size, WavefrontData& outData, JobSystem* jobs) {
+
+    outData.Clear();
+
+    // Cut the text into chunks of whole lines, a few per thread so a slow chunk doesn't hold up the rest. With one
+    // thread the whole text is one chunk.
+    const uint32_t threads = (jobs == nullptr) ? 1 : jobs->ThreadCount();
+    size_t chunkBytes = size;
+
+    if (threads > 1) {
+        chunkBytes = size / (static_cast<size_t>(threads) * WAVEFRONT_CHUNKS_PER_THREAD) + 1;
+        chunkBytes = (chunkBytes < WAVEFRONT_MIN_CHUNK_BYTES) ? WAVEFRONT_MIN_CHUNK_BYTES : chunkBytes;
+    }
+
+    std::vector<WavefrontChunk> chunks;
+    const char* end = text + size;
+
+    for (const char* begin = text; begin < end;) {
+        const char* chunkEnd = (static_cast<size_t>(end - begin) <= chunkBytes) ? end : SkipLine(begin + chunkBytes, end);
+
+        chunks.emplace_back();
+        chunks.back().Begin = begin;
+        chunks.back().End = chunkEnd;
+        begin = chunkEnd;
+    }
+
+    const auto parse = [&](uint32_t first, uint32_t last) {
+        for (uint32_t i = first; i < last; i++) {
+            ParseChunk(chunks[i]);
+        }
+    };
+
+    if (jobs == nullptr) {
+        parse(0, static_cast<uint32_t>(chunks.size()));
+    }
+    else {
+        jobs->ParallelFor(0, static_cast<uint32_t>(chunks.size()), 1, parse);
+    }
+
+    // Lay the chunks out one after another, in file order, and find where each usemtl lands in the merged corners.
+    size_t totals[4] = { 0, 0, 0, 0 };
+    std::vector<size_t> surfaceStarts;
+
+    for (WavefrontChunk& chunk : chunks) {
+        if (chunk.ErrorLine != nullptr) {
+            const size_t lineNumber = 1 + std::count(text, chunk.ErrorLine, '\n');
+            std::cout << "Wavefront: Malformed line " << lineNumber << "." << std::endl;
+            return false;
+        }
+
+        for (uint32_t start : chunk.SurfaceStarts) {
+            surfaceStarts.push_back(totals[3] + start);
+        }
+
+        if (chunk.HasName) {
+            outData.Name = chunk.Name;
+        }
+
+        chunk.Counts[0] = chunk.Positions.size();
+        chunk.Counts[1] = chunk.TextureCoords.size();
+        chunk.Counts[2] = chunk.Normals.size();
+        chunk.Counts[3] = chunk.PositionIndices.size();
+
+        for (int i = 0; i < 4; i++) {
+            chunk.Offsets[i] = totals[i];
+            totals[i] += chunk.Counts[i];
+        }
+    }
+
+    if (chunks.size() == 1) {
+        // Nothing to lay out, so take the lists as they are.
+        outData.Positions = std::move(chunks[0].Positions);
+        outData.TextureCoords = std::move(chunks[0].TextureCoords);
+        outData.Normals = std::move(chunks[0].Normals);
+        outData.PositionIndices = std::move(chunks[0].PositionIndices);
+        outData.TextureCoordIndices = std::move(chunks[0].TextureCoordIndices);
+        outData.NormalIndices = std::move(chunks[0].NormalIndices);
+
+        chunks[0].Positions.clear();
+        chunks[0].TextureCoords.clear();
+        chunks[0].Normals.clear();
+        chunks[0].PositionIndices.clear();
+        chunks[0].TextureCoordIndices.clear();
+        chunks[0].NormalIndices.clear();
+    }
+    else {
+        outData.Positions.resize(totals[0]);
+        outData.TextureCoords.resize(totals[1]);
+        outData.Normals.resize(totals[2]);
+        outData.PositionIndices.resize(totals[3]);
+        outData.TextureCoordIndices.resize(totals[3]);
+        outData.NormalIndices.resize(totals[3]);
+    }
+
+    std::atomic<bool> valid(true);
+
+    const auto merge = [&](uint32_t first, uint32_t last) {
+        for (uint32_t i = first; i < last; i++) {
+            if (!MergeChunk(chunks[i], outData)) {
+                valid.store(false, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    if (jobs == nullptr) {
+        merge(0, static_cast<uint32_t>(chunks.size()));
+    }
+    else {
+        jobs->ParallelFor(0, static_cast<uint32_t>(chunks.size()), 1, merge);
+    }
+
+    if (!valid.load()) {
+        std::cout << "Wavefront: A face uses an index outside of its list." << std::endl;
+        return false;
+    }
+
+    // Each usemtl starts a new surface. Surfaces without faces are dropped.
+    surfaceStarts.push_back(totals[3]);
+    size_t surfaceStart = 0;
+
+    for (size_t start : surfaceStarts) {
+        if (start > surfaceStart) {
+            outData.SurfaceIndexCounts.push_back(static_cast<uint32_t>(start - surfaceStart));
+            surfaceStart = start;
+        }
+    }
+
+    if (outData.SurfaceIndexCounts.empty()) {
+        outData.SurfaceIndexCounts.push_back(0);
+    }
+
+    return true;
+}
+
+bool LoadWavefront(const char* path, WavefrontData& outData, JobSystem* jobs) {
+
+    MappedFile file;
+
+    if (!file.Open(path)) {
+        std::cout << "Wavefront (" << path << ") not found." << std::endl;
+        return false;
+    }
+
+    return ParseWavefront(file.Data(), file.Size(), outData, jobs);
+}
+
+static uint64_t HashCorner(uint32_t position, uint32_t textureCoord, uint32_t normal) {
+    /* Mix the three indices of a corner so every one of them reaches the low bits that pick a slot. */
+
+    uint64_t hash = (static_cast<uint64_t>(position) << 32 | textureCoord) * 0x9E3779B97F4A7C15;
+    hash ^= (hash >> 29) ^ (static_cast<uint64_t>(normal) * 0xC2B2AE3D27D4EB4F);
+    hash ^= hash >> 32;
+    return hash;
+}
+
+void BuildWavefrontVertices(const WavefrontData& data, std::vector<Vertex>& outVertices, std::vector<uint32_t>& outIndices) {
+    /* Corners are deduplicated with an open addressing table of vertex indices, probed linearly. The table is kept
+    at most half full and starts with room for one vertex per position, which is the usual count for smooth meshes. */
+
+    const size_t corners = data.PositionIndices.size();
+
+    // The corners each vertex was made from, compared on a hash hit.
+    std::vector<uint32_t> keys;
+
+    size_t tableSize = 16;
+    while (tableSize < data.Positions.size() * 2) {
+        tableSize <<= 1;
+    }
+    std::vector<uint32_t> table(tableSize, WAVEFRONT_MISSING_INDEX);
+
+    outVertices.clear();
+    outIndices.resize(corners);
+    outVertices.reserve(data.Positions.size());
+    keys.reserve(data.Positions.size() * 3);
+
+    for (size_t i = 0; i < corners; i++) {
+        const uint32_t position = data.PositionIndices[i];
+        const uint32_t textureCoord = data.TextureCoordIndices[i];
+        const uint32_t normal = data.NormalIndices[i];
+
+        size_t slot = HashCorner(position, textureCoord, normal) & (tableSize - 1);
+
+        while (table[slot] != WAVEFRONT_MISSING_INDEX) {
+            const uint32_t* key = &keys[table[slot] * 3];
+            if (key[0] == position && key[1] == textureCoord && key[2] == normal) {
+                break;
+            }
+            slot = (slot + 1) & (tableSize - 1);
+        }
+
+        if (table[slot] != WAVEFRONT_MISSING_INDEX) {
+            outIndices[i] = table[slot];
+            continue;
+        }
+
+        const uint32_t vertex = static_cast<uint32_t>(outVertices.size());
+        table[slot] = vertex;
+        outIndices[i] = vertex;
+
+        keys.push_back(position);
+        keys.push_back(textureCoord);
+        keys.push_back(normal);
+
+        Vertex newVertex;
+        newVertex.position = data.Positions[position];
+        newVertex.normal = (normal == WAVEFRONT_MISSING_INDEX) ? Vector3{ 0.0f, 1.0f, 0.0f } : data.Normals[normal];
+        newVertex.textureCoord = (textureCoord == WAVEFRONT_MISSING_INDEX) ? Vector2{ 0.0f, 0.0f } : data.TextureCoords[textureCoord];
+        outVertices.push_back(newVertex);
+
+        // Grow before the table is more than half full, and put every vertex back in by its corner.
+        if (outVertices.size() * 2 > tableSize) {
+            tableSize <<= 1;
+            table.assign(tableSize, WAVEFRONT_MISSING_INDEX);
+
+            for (uint32_t v = 0; v < static_cast<uint32_t>(outVertices.size()); v++) {
+                size_t rehashed = HashCorner(keys[v * 3], keys[v * 3 + 1], keys[v * 3 + 2]) & (tableSize - 1);
+                while (table[rehashed] != WAVEFRONT_MISSING_INDEX) {
+                    rehashed = (rehashed + 1) & (tableSize - 1);
+                }
+                table[rehashed] = v;
+            }
+        }
+    }
+}